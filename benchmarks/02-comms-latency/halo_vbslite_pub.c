@@ -2,14 +2,18 @@
  * VBSLite Publisher (Halo OS)
  * Publishes sensor data at 1kHz and toggles GPIO for E2E measurement
  * API: Fast DDS (eProsima) wrapper via Rte_Dds_*
+ * Rte_Dds_Publish is wrapped in PMU counters (bench_perf.h), reported
+ * once on Ctrl+C so printing never lands inside the 1 ms publish period
  */
 
 #include <stdio.h>
 #include <stdint.h>
 #include <unistd.h>
+#include <signal.h>
 #include <time.h>
 #include <vbslite/Rte_Dds.h>
 #include <vcos/vcos_gpio.h>
+#include "bench_perf.h"
 
 #define TOPIC_NAME "SensorData"
 #define PUB_RATE_HZ 1000
@@ -22,6 +26,13 @@ typedef struct {
     uint32_t sequence;
 } SensorData_t;
 
+static volatile sig_atomic_t running = 1;
+
+static void on_sigint(int sig) {
+    (void)sig;
+    running = 0;
+}
+
 int main(void) {
     printf("=== Halo OS VBSLite Publisher ===\n");
     
@@ -43,14 +54,18 @@ int main(void) {
     vcos_gpio_init(&gpio_trigger, GPIO_PIN_20);  // P20.0 on TC397
     vcos_gpio_set_direction(&gpio_trigger, VCOS_GPIO_OUTPUT);
     
+    bench_perf_region_t perf_publish;
+    bench_perf_open(&perf_publish, "Rte_Dds_Publish");
+
     /* Publishing loop */
     SensorData_t data;
     uint32_t seq = 0;
     
     printf("Publishing at %d Hz on topic '%s'\n", PUB_RATE_HZ, TOPIC_NAME);
     printf("Press Ctrl+C to stop\n\n");
+    signal(SIGINT, on_sigint);
     
-    while (1) {
+    while (running) {
         struct timespec ts;
         clock_gettime(CLOCK_MONOTONIC, &ts);
         data.timestamp_us = ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
@@ -65,7 +80,9 @@ int main(void) {
         vcos_gpio_write(&gpio_trigger, 1);
         
         /* Publish */
+        bench_perf_begin(&perf_publish);
         Rte_Dds_Publish(pub, &data);
+        bench_perf_end(&perf_publish, 1);
         
         /* Toggle GPIO LOW after publish */
         vcos_gpio_write(&gpio_trigger, 0);
@@ -77,6 +94,8 @@ int main(void) {
         usleep(1000000 / PUB_RATE_HZ);  // 1ms
     }
     
+    bench_perf_report(&perf_publish);
+    bench_perf_close(&perf_publish);
     Rte_Dds_DeletePublisher(pub);
     Rte_Dds_Deinit();
     
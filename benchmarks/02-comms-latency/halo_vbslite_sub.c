@@ -1,6 +1,7 @@
 /*
  * VBSLite Subscriber (Halo OS)
  * Receives sensor data and toggles GPIO for E2E measurement
+ * The receive callback is wrapped in PMU counters (bench_perf.h)
  */
 
 #include <stdio.h>
@@ -9,6 +10,8 @@
 #include <time.h>
 #include <vbslite/Rte_Dds.h>
 #include <vcos/vcos_gpio.h>
+#include "bench_perf.h"
+#include "bench_stats.h"
 
 #define TOPIC_NAME "SensorData"
 
@@ -22,6 +25,8 @@ typedef struct {
 
 static uint64_t latencies[10000];
 static int latency_count = 0;
+static bench_perf_region_t perf_callback;
+static volatile int perf_opened;
 
 static inline uint64_t get_timestamp_us(void) {
     struct timespec ts;
@@ -32,18 +37,25 @@ static inline uint64_t get_timestamp_us(void) {
 void data_callback(void *data, size_t size) {
     SensorData_t *sensor = (SensorData_t *)data;
     uint64_t now = get_timestamp_us();
+    if (!perf_opened) {
+        /* PMU counters are per core: open where the callback runs */
+        bench_perf_open(&perf_callback, "data_callback");
+        perf_opened = 1;
+    }
+    bench_perf_begin(&perf_callback);
     
     /* Calculate E2E latency */
     uint64_t latency = now - sensor->timestamp_us;
     
     if (latency_count < 10000) {
-        latencies[latency_count++] = latency;
+        latencies[latency_count++] = latency * 1000;  // bench_stats works in ns
     }
     
     if (sensor->sequence % 1000 == 0) {
         printf("Received seq %u, E2E latency: %lu µs\n", 
                sensor->sequence, latency);
     }
+    bench_perf_end(&perf_callback, 1);
 }
 
 int main(void) {
@@ -69,24 +81,16 @@ int main(void) {
     sleep(60);  // Run for 60 seconds
     
     /* Calculate stats */
-    uint64_t min = UINT64_MAX, max = 0, sum = 0;
-    for (int i = 0; i < latency_count; i++) {
-        if (latencies[i] < min) min = latencies[i];
-        if (latencies[i] > max) max = latencies[i];
-        sum += latencies[i];
-    }
-    
-    printf("\nE2E Latency Statistics:\n");
-    printf("  Min:    %lu µs\n", min);
-    printf("  Avg:    %lu µs\n", sum / latency_count);
-    printf("  Max:    %lu µs\n", max);
+    bench_stats_t s;
+    bench_stats_compute(latencies, latency_count, &s);
+    bench_stats_print("E2E Latency Statistics", &s);
     
     /* Verdict on <1ms claim */
-    uint64_t avg = sum / latency_count;
-    if (avg < 1000) {
-        printf("✓ PASS: Validates <1ms claim (avg = %lu µs)\n", avg);
-    } else {
-        printf("✗ FAIL: Does not meet <1ms (avg = %lu µs)\n", avg);
+    bench_stats_verdict(&s, 1000);
+
+    if (perf_opened) {
+        bench_perf_report(&perf_callback);
+        bench_perf_close(&perf_callback);
     }
     
     /* Cleanup */
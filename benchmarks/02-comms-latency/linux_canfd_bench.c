@@ -0,0 +1,752 @@
+/*
+ * CAN-FD Signal Latency Benchmark (Linux SocketCAN)
+ * Packs SensorData into a 24-byte CAN-FD frame and measures frame-to-callback
+ * latency, throughput at configurable bus-load levels and the cost of
+ * batched sendmmsg/recvmmsg, optionally splitting latency at the kernel
+ * RX timestamp.
+ *
+ * Runs on vcan0 (see setup_vcan.sh) or a real CAN-FD interface (can0 with
+ * "fd on"). Bus load comes from a background sender on a lower CAN ID,
+ * paced so sensor + background frames fill the target share of the bus at
+ * the configured bitrates. On a real bus it wins arbitration against the
+ * measured frames; vcan has no arbitration, so there it only competes for
+ * the socket queues and the softirq path.
+ * -P adds hardware counters around recvmsg/recvmmsg + callbacks in latency
+ * and batch mode (bench_perf.h). The counter enable runs before the receive
+ * syscall, so with -P frame-to-callback latency includes it.
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <getopt.h>
+#include <pthread.h>
+#include <poll.h>
+#include <time.h>
+#include <net/if.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <linux/can.h>
+#include <linux/can/raw.h>
+#include <linux/net_tstamp.h>
+#include <linux/errqueue.h>
+#include "bench_stats.h"
+#include "bench_rt.h"
+#include "bench_perf.h"
+
+#define DEFAULT_IFNAME "vcan0"
+#define SENSOR_CAN_ID 0x123
+#define LOAD_CAN_ID 0x010  // lower ID wins arbitration against the sensor frames
+#define SENSOR_FRAME_LEN 24  // valid CAN-FD DLC length
+#define DEFAULT_SAMPLES 10000
+#define DEFAULT_PERIOD_US 1000  // 1kHz, same rate as halo_vbslite_pub.c
+#define MAX_BATCH 64
+#define MAX_LOAD_LEVELS 16
+#define NOMINAL_BITRATE 500000
+#define DATA_BITRATE 2000000
+#define MIN_RX_TIMEOUT_MS 1000  // idle timeout is max(this, 10 TX periods)
+
+typedef struct {
+    uint64_t timestamp_us;
+    float imu_accel_x;
+    float imu_accel_y;
+    float imu_accel_z;
+    uint32_t sequence;
+} SensorData_t;
+
+typedef enum {
+    MODE_LATENCY,
+    MODE_BUSLOAD,
+    MODE_BATCH,
+} bench_mode_t;
+
+typedef struct {
+    const char *ifname;
+    bench_mode_t mode;
+    int samples;
+    int period_us;
+    int batch;
+    int kernel_ts;
+    int nominal_bitrate;
+    int data_bitrate;
+    int load_levels[MAX_LOAD_LEVELS];
+    int load_count;
+    int perf;
+    const char *csv_path;
+} bench_config_t;
+
+/* Per-phase state shared between the TX loop and the RX thread */
+typedef struct {
+    int rx_fd;
+    int samples;
+    int batch;
+    int kernel_ts;
+    int rx_timeout_ms;      // no frame for this long: remaining frames are lost
+    uint64_t *tx_mono_ns;   // indexed by sequence
+    uint64_t *tx_real_ns;   // CLOCK_REALTIME twin for the kernel stamp split
+    uint64_t *latencies;    // frame-to-callback
+    uint64_t *stack_in;     // TX -> kernel RX stamp
+    uint64_t *wakeup;       // kernel RX stamp -> callback
+    int latency_count;
+    int stamp_count;
+    int hw_stamp_count;
+    int rx_frames;
+    int rx_syscalls;
+    uint64_t rx_busy_ns;    // recvmmsg + callbacks only, not the wait
+    int load_fd;
+    uint64_t load_period_ns;  // background frame period, 0 = no bus load
+    uint64_t load_frames;
+    volatile int load_stop;
+    const char *perf_name;  // counters around RX handling, NULL = off
+    bench_perf_region_t perf_rx;
+} phase_t;
+
+/* Explicit little-endian packing; never put the raw struct on the bus */
+static void put_le32(uint8_t *p, uint32_t v) {
+    p[0] = v; p[1] = v >> 8; p[2] = v >> 16; p[3] = v >> 24;
+}
+
+static uint32_t get_le32(const uint8_t *p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void put_f32(uint8_t *p, float f) {
+    uint32_t v;
+    memcpy(&v, &f, sizeof(v));
+    put_le32(p, v);
+}
+
+static float get_f32(const uint8_t *p) {
+    uint32_t v = get_le32(p);
+    float f;
+    memcpy(&f, &v, sizeof(f));
+    return f;
+}
+
+static void sensor_pack(const SensorData_t *d, struct canfd_frame *frame) {
+    memset(frame, 0, sizeof(*frame));
+    frame->can_id = SENSOR_CAN_ID;
+    frame->len = SENSOR_FRAME_LEN;
+    frame->flags = CANFD_BRS;
+    put_le32(&frame->data[0], (uint32_t)d->timestamp_us);
+    put_le32(&frame->data[4], (uint32_t)(d->timestamp_us >> 32));
+    put_f32(&frame->data[8], d->imu_accel_x);
+    put_f32(&frame->data[12], d->imu_accel_y);
+    put_f32(&frame->data[16], d->imu_accel_z);
+    put_le32(&frame->data[20], d->sequence);
+}
+
+static void sensor_unpack(const struct canfd_frame *frame, SensorData_t *d) {
+    d->timestamp_us = get_le32(&frame->data[0]) |
+                      ((uint64_t)get_le32(&frame->data[4]) << 32);
+    d->imu_accel_x = get_f32(&frame->data[8]);
+    d->imu_accel_y = get_f32(&frame->data[12]);
+    d->imu_accel_z = get_f32(&frame->data[16]);
+    d->sequence = get_le32(&frame->data[20]);
+}
+
+/*
+ * On-wire time of one CAN-FD frame with bit-rate switching.
+ * Arbitration phase (SOF..BRS, CRC delimiter..IFS) at the nominal rate,
+ * ESI/DLC/data/CRC at the data rate; dynamic stuffing taken at the
+ * worst case of one stuff bit per four bits.
+ */
+static uint64_t canfd_frame_time_ns(int len, int nominal_bps, int data_bps) {
+    int nominal_bits = 17 + 13;
+    int crc_bits = (len > 16) ? 21 : 17;
+    int data_bits = 1 + 4 + len * 8 + 4 + crc_bits;
+    data_bits += data_bits / 4;
+    return (uint64_t)nominal_bits * 1000000000ULL / nominal_bps +
+           (uint64_t)data_bits * 1000000000ULL / data_bps;
+}
+
+static int open_can_socket(const char *ifname, int rx, int kernel_ts) {
+    int fd = socket(PF_CAN, SOCK_RAW, CAN_RAW);
+    if (fd < 0) {
+        perror("socket(PF_CAN)");
+        return -1;
+    }
+
+    int enable = 1;
+    if (setsockopt(fd, SOL_CAN_RAW, CAN_RAW_FD_FRAMES, &enable, sizeof(enable)) < 0) {
+        perror("CAN_RAW_FD_FRAMES");
+        close(fd);
+        return -1;
+    }
+
+    struct ifreq ifr;
+    memset(&ifr, 0, sizeof(ifr));
+    strncpy(ifr.ifr_name, ifname, IFNAMSIZ - 1);
+    if (ioctl(fd, SIOCGIFMTU, &ifr) < 0) {
+        fprintf(stderr, "Interface %s not found (run setup_vcan.sh)\n", ifname);
+        close(fd);
+        return -1;
+    }
+    if (ifr.ifr_mtu != CANFD_MTU) {
+        fprintf(stderr, "Interface %s is not CAN-FD capable (mtu must be %d)\n",
+                ifname, (int)CANFD_MTU);
+        close(fd);
+        return -1;
+    }
+    if (ioctl(fd, SIOCGIFINDEX, &ifr) < 0) {
+        perror("SIOCGIFINDEX");
+        close(fd);
+        return -1;
+    }
+
+    if (rx) {
+        struct can_filter filter = { .can_id = SENSOR_CAN_ID, .can_mask = CAN_SFF_MASK };
+        setsockopt(fd, SOL_CAN_RAW, CAN_RAW_FILTER, &filter, sizeof(filter));
+
+        int rcvbuf = 4 * 1024 * 1024;
+        setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+
+        if (kernel_ts) {
+            int flags = SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE |
+                        SOF_TIMESTAMPING_RX_HARDWARE | SOF_TIMESTAMPING_RAW_HARDWARE;
+            if (setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags)) < 0) {
+                perror("SO_TIMESTAMPING");
+            }
+        }
+    } else {
+        /* TX-only socket: drop everything so its queue never fills */
+        setsockopt(fd, SOL_CAN_RAW, CAN_RAW_FILTER, NULL, 0);
+    }
+
+    struct sockaddr_can addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.can_family = AF_CAN;
+    addr.can_ifindex = ifr.ifr_ifindex;
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        perror("bind(can)");
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+/* Receive callback: the point where the application sees the signal */
+static void frame_callback(phase_t *ph, const struct canfd_frame *frame,
+                           const struct scm_timestamping *stamps) {
+    uint64_t now = bench_now_ns(CLOCK_MONOTONIC);
+    SensorData_t sensor;
+    sensor_unpack(frame, &sensor);
+
+    if (sensor.sequence >= (uint32_t)ph->samples) {
+        return;
+    }
+
+    uint64_t tx = __atomic_load_n(&ph->tx_mono_ns[sensor.sequence], __ATOMIC_ACQUIRE);
+    if (tx == 0 || ph->latency_count >= ph->samples) {
+        return;
+    }
+    ph->latencies[ph->latency_count++] = now - tx;
+
+    if (stamps && (stamps->ts[0].tv_sec || stamps->ts[0].tv_nsec)) {
+        uint64_t kernel = bench_timespec_ns(&stamps->ts[0]);
+        uint64_t real_now = bench_now_ns(CLOCK_REALTIME);
+        uint64_t tx_real = ph->tx_real_ns[sensor.sequence];
+        if (kernel >= tx_real && real_now >= kernel) {
+            ph->stack_in[ph->stamp_count] = kernel - tx_real;
+            ph->wakeup[ph->stamp_count] = real_now - kernel;
+            ph->stamp_count++;
+        }
+    }
+    /* Raw hardware stamps are in the controller's clock domain; only counted */
+    if (stamps && (stamps->ts[2].tv_sec || stamps->ts[2].tv_nsec)) {
+        ph->hw_stamp_count++;
+    }
+
+    if (sensor.sequence % 1000 == 0) {
+        printf("Received seq %u, frame-to-callback: %.2f µs\n",
+               sensor.sequence, (now - tx) / 1000.0);
+    }
+}
+
+static void *rx_thread(void *arg) {
+    phase_t *ph = arg;
+    struct canfd_frame frames[MAX_BATCH];
+    struct iovec iov[MAX_BATCH];
+    struct mmsghdr msgs[MAX_BATCH];
+    char ctrl[MAX_BATCH][CMSG_SPACE(sizeof(struct scm_timestamping))];
+
+    if (ph->perf_name) {
+        /* Counters follow the opening thread, so open on the RX thread */
+        bench_perf_open(&ph->perf_rx, ph->perf_name);
+    }
+
+    while (ph->rx_frames < ph->samples) {
+        for (int i = 0; i < ph->batch; i++) {
+            iov[i].iov_base = &frames[i];
+            iov[i].iov_len = sizeof(frames[i]);
+            memset(&msgs[i], 0, sizeof(msgs[i]));
+            msgs[i].msg_hdr.msg_iov = &iov[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+            msgs[i].msg_hdr.msg_control = ctrl[i];
+            msgs[i].msg_hdr.msg_controllen = sizeof(ctrl[i]);
+        }
+
+        /* Wait outside the timed region, so RX ns/frame is syscall + callback cost */
+        struct pollfd pfd = { .fd = ph->rx_fd, .events = POLLIN };
+        int ready = poll(&pfd, 1, ph->rx_timeout_ms);
+        if (ready < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ready <= 0) {
+            break;  // idle timeout: remaining frames are lost
+        }
+
+        uint64_t t0 = bench_now_ns(CLOCK_MONOTONIC);
+        if (ph->perf_name) bench_perf_begin(&ph->perf_rx);
+        int n;
+        if (ph->batch > 1) {
+            n = recvmmsg(ph->rx_fd, msgs, ph->batch, MSG_DONTWAIT, NULL);
+        } else {
+            ssize_t r = recvmsg(ph->rx_fd, &msgs[0].msg_hdr, MSG_DONTWAIT);
+            n = (r < 0) ? -1 : 1;
+            msgs[0].msg_len = (r < 0) ? 0 : (unsigned int)r;
+        }
+        if (n < 0) {
+            if (ph->perf_name) bench_perf_end(&ph->perf_rx, 0);
+            if (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK) {
+                continue;
+            }
+            perror("recvmmsg(can)");
+            break;
+        }
+
+        ph->rx_syscalls++;
+        for (int i = 0; i < n; i++) {
+            if (msgs[i].msg_len != CANFD_MTU) {
+                continue;
+            }
+            struct scm_timestamping *stamps = NULL;
+            for (struct cmsghdr *cm = CMSG_FIRSTHDR(&msgs[i].msg_hdr); cm;
+                 cm = CMSG_NXTHDR(&msgs[i].msg_hdr, cm)) {
+                if (cm->cmsg_level == SOL_SOCKET && cm->cmsg_type == SCM_TIMESTAMPING) {
+                    stamps = (struct scm_timestamping *)CMSG_DATA(cm);
+                }
+            }
+            frame_callback(ph, &frames[i], stamps);
+            ph->rx_frames++;
+        }
+        if (ph->perf_name) bench_perf_end(&ph->perf_rx, n);
+        ph->rx_busy_ns += bench_now_ns(CLOCK_MONOTONIC) - t0;
+    }
+
+    return NULL;
+}
+
+/* Competing traffic: same-size frames on LOAD_CAN_ID at load_period_ns */
+static void *load_thread(void *arg) {
+    phase_t *ph = arg;
+    struct canfd_frame frame;
+    memset(&frame, 0, sizeof(frame));
+    frame.can_id = LOAD_CAN_ID;
+    frame.len = SENSOR_FRAME_LEN;
+    frame.flags = CANFD_BRS;
+
+    uint64_t next = bench_now_ns(CLOCK_MONOTONIC);
+    while (!ph->load_stop) {
+        if (write(ph->load_fd, &frame, CANFD_MTU) == CANFD_MTU) {
+            ph->load_frames++;
+        } else if (errno != ENOBUFS) {  // full TX queue: frame dropped, keep pacing
+            perror("write(can load)");
+            break;
+        }
+        next += ph->load_period_ns;
+        bench_sleep_until(next);
+    }
+    return NULL;
+}
+
+/*
+ * One measurement phase: RX thread on its own socket, TX paced at
+ * period_ns per batch of `batch` frames, plus background load when
+ * ph->load_period_ns is set. Returns achieved TX syscall cost.
+ */
+static int run_phase(const bench_config_t *cfg, phase_t *ph, uint64_t period_ns,
+                     int batch, uint64_t *tx_ns_per_frame, uint64_t *elapsed_ns) {
+    int tx_fd = open_can_socket(cfg->ifname, 0, 0);
+    if (tx_fd < 0) {
+        return -1;
+    }
+    ph->rx_fd = open_can_socket(cfg->ifname, 1, cfg->kernel_ts);
+    if (ph->rx_fd < 0) {
+        close(tx_fd);
+        return -1;
+    }
+    ph->load_fd = -1;
+    if (ph->load_period_ns) {
+        ph->load_fd = open_can_socket(cfg->ifname, 0, 0);
+        if (ph->load_fd < 0) {
+            close(ph->rx_fd);
+            close(tx_fd);
+            return -1;
+        }
+    }
+    ph->samples = cfg->samples;
+    ph->batch = batch;
+    ph->kernel_ts = cfg->kernel_ts;
+    ph->rx_timeout_ms = MIN_RX_TIMEOUT_MS;
+    if (period_ns / 100000 > (uint64_t)ph->rx_timeout_ms) {
+        ph->rx_timeout_ms = (int)(period_ns / 100000);
+    }
+
+    pthread_t rx, load;
+    int rc = bench_spawn(&rx, rx_thread, ph, -1, 0);
+    if (rc == 0 && ph->load_fd >= 0 && (rc = bench_spawn(&load, load_thread, ph, -1, 0)) != 0) {
+        ph->samples = 0;  // lets the RX thread exit
+        pthread_join(rx, NULL);
+    }
+    if (rc != 0) {
+        fprintf(stderr, "pthread_create: %s\n", strerror(rc));
+        if (ph->load_fd >= 0) {
+            close(ph->load_fd);
+        }
+        close(ph->rx_fd);
+        close(tx_fd);
+        return -1;
+    }
+
+    struct canfd_frame frames[MAX_BATCH];
+    struct iovec iov[MAX_BATCH];
+    struct mmsghdr msgs[MAX_BATCH];
+    uint64_t tx_busy = 0;
+    uint32_t seq = 0;
+    uint64_t start = bench_now_ns(CLOCK_MONOTONIC);
+    uint64_t next = start;
+
+    while (seq < (uint32_t)cfg->samples) {
+        int n = batch;
+        if (seq + n > (uint32_t)cfg->samples) {
+            n = cfg->samples - seq;
+        }
+
+        uint64_t t0 = bench_now_ns(CLOCK_MONOTONIC);
+        for (int i = 0; i < n; i++) {
+            SensorData_t data;
+            data.timestamp_us = t0 / 1000;
+            data.imu_accel_x = 0.1f * (seq + i);
+            data.imu_accel_y = 0.2f * (seq + i);
+            data.imu_accel_z = 9.8f;
+            data.sequence = seq + i;
+            sensor_pack(&data, &frames[i]);
+
+            iov[i].iov_base = &frames[i];
+            iov[i].iov_len = CANFD_MTU;
+            memset(&msgs[i], 0, sizeof(msgs[i]));
+            msgs[i].msg_hdr.msg_iov = &iov[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+
+            ph->tx_real_ns[seq + i] = bench_now_ns(CLOCK_REALTIME);
+            __atomic_store_n(&ph->tx_mono_ns[seq + i], bench_now_ns(CLOCK_MONOTONIC),
+                             __ATOMIC_RELEASE);
+        }
+
+        int sent;
+        uint64_t s0 = bench_now_ns(CLOCK_MONOTONIC);
+        if (batch > 1) {
+            sent = sendmmsg(tx_fd, msgs, n, 0);
+        } else {
+            sent = (write(tx_fd, &frames[0], CANFD_MTU) == CANFD_MTU) ? 1 : -1;
+        }
+        tx_busy += bench_now_ns(CLOCK_MONOTONIC) - s0;
+
+        if (sent < 0) {
+            if (errno == ENOBUFS) {
+                /* TX queue full on a real bus: back off and retry the batch */
+                usleep(100);
+                continue;
+            }
+            perror("send(can)");
+            break;
+        }
+        seq += sent;
+
+        next += period_ns;
+        bench_sleep_until(next);
+    }
+
+    *elapsed_ns = bench_now_ns(CLOCK_MONOTONIC) - start;
+    *tx_ns_per_frame = seq ? tx_busy / seq : 0;
+
+    if (ph->load_fd >= 0) {
+        ph->load_stop = 1;
+        pthread_join(load, NULL);
+        close(ph->load_fd);
+    }
+    pthread_join(rx, NULL);
+    close(ph->rx_fd);
+    close(tx_fd);
+    return 0;
+}
+
+static phase_t *phase_alloc(int samples) {
+    phase_t *ph = calloc(1, sizeof(*ph));
+    if (!ph) {
+        return NULL;
+    }
+    ph->tx_mono_ns = calloc(samples, sizeof(uint64_t));
+    ph->tx_real_ns = calloc(samples, sizeof(uint64_t));
+    ph->latencies = calloc(samples, sizeof(uint64_t));
+    ph->stack_in = calloc(samples, sizeof(uint64_t));
+    ph->wakeup = calloc(samples, sizeof(uint64_t));
+    if (!ph->tx_mono_ns || !ph->tx_real_ns || !ph->latencies ||
+        !ph->stack_in || !ph->wakeup) {
+        fprintf(stderr, "Out of memory for %d samples\n", samples);
+        exit(1);
+    }
+    return ph;
+}
+
+static void phase_free(phase_t *ph) {
+    if (ph->perf_rx.name) {
+        bench_perf_close(&ph->perf_rx);
+    }
+    free(ph->tx_mono_ns);
+    free(ph->tx_real_ns);
+    free(ph->latencies);
+    free(ph->stack_in);
+    free(ph->wakeup);
+    free(ph);
+}
+
+static void print_kernel_split(const phase_t *ph) {
+    if (ph->stamp_count == 0) {
+        printf("\n⚠ No kernel RX timestamps received\n");
+        return;
+    }
+    bench_stats_t s;
+    bench_stats_compute(ph->stack_in, ph->stamp_count, &s);
+    bench_stats_print("TX → kernel RX timestamp", &s);
+    bench_stats_compute(ph->wakeup, ph->stamp_count, &s);
+    bench_stats_print("Kernel RX timestamp → callback", &s);
+    /* Support check only: raw stamps are not in the system clock domain */
+    printf("  Hardware RX stamps: %d of %d frames\n", ph->hw_stamp_count, ph->rx_frames);
+}
+
+static int run_latency(const bench_config_t *cfg) {
+    printf("Mode: latency, %d frames at %d µs period\n\n", cfg->samples, cfg->period_us);
+
+    phase_t *ph = phase_alloc(cfg->samples);
+    if (cfg->perf) {
+        ph->perf_name = "RX (recvmsg + callback)";
+    }
+    uint64_t tx_cost, elapsed;
+    if (run_phase(cfg, ph, cfg->period_us * 1000ULL, 1, &tx_cost, &elapsed) < 0) {
+        phase_free(ph);
+        return 1;
+    }
+
+    bench_stats_t s;
+    bench_stats_compute(ph->latencies, ph->latency_count, &s);
+    bench_stats_print("Frame-to-callback Latency Statistics", &s);
+    printf("  Lost:   %d frames\n", cfg->samples - ph->rx_frames);
+    if (cfg->kernel_ts) {
+        print_kernel_split(ph);
+    }
+    if (ph->perf_rx.name) {
+        bench_perf_report(&ph->perf_rx);
+    }
+    printf("\n");
+    if (cfg->csv_path) {
+        bench_stats_save_csv(cfg->csv_path, ph->latencies, ph->latency_count);
+    }
+    int pass = bench_stats_verdict(&s, 1000);
+
+    phase_free(ph);
+    return pass ? 0 : 2;
+}
+
+static int run_busload(const bench_config_t *cfg) {
+    uint64_t frame_ns = canfd_frame_time_ns(SENSOR_FRAME_LEN, cfg->nominal_bitrate,
+                                            cfg->data_bitrate);
+    uint64_t period_ns = cfg->period_us * 1000ULL;
+    printf("Mode: bus load, %d sensor frames per level at %d µs period\n",
+           cfg->samples, cfg->period_us);
+    printf("Bitrate: %d / %d bit/s, frame time %.2f µs, background ID 0x%03X\n\n",
+           cfg->nominal_bitrate, cfg->data_bitrate, frame_ns / 1000.0, LOAD_CAN_ID);
+
+    printf("%-8s %-12s %-12s %-10s %-10s %-10s %-10s %-6s\n",
+           "Load %", "Bus fr/s", "Load fr/s", "Min µs", "Avg µs", "P99 µs", "Max µs", "Lost");
+    printf("----------------------------------------------------------------------------------\n");
+
+    for (int i = 0; i < cfg->load_count; i++) {
+        int load = cfg->load_levels[i];
+        /* Background fills what the sensor stream leaves of the target share */
+        double bus_fps = load / 100.0 * 1e9 / frame_ns;
+        double sensor_fps = period_ns ? 1e9 / period_ns : bus_fps;
+
+        phase_t *ph = phase_alloc(cfg->samples);
+        if (bus_fps > sensor_fps) {
+            ph->load_period_ns = (uint64_t)(1e9 / (bus_fps - sensor_fps));
+        }
+        uint64_t tx_cost, elapsed;
+        if (run_phase(cfg, ph, period_ns, 1, &tx_cost, &elapsed) < 0) {
+            phase_free(ph);
+            return 1;
+        }
+
+        bench_stats_t s;
+        bench_stats_compute(ph->latencies, ph->latency_count, &s);
+        double load_fps = ph->load_frames * 1e9 / elapsed;
+        printf("%-8d %-12.0f %-12.0f %-10.2f %-10.2f %-10.2f %-10.2f %-6d\n",
+               load, ph->rx_frames * 1e9 / elapsed + load_fps, load_fps,
+               s.min_ns / 1000.0, s.avg_ns / 1000.0, s.p99_ns / 1000.0,
+               s.max_ns / 1000.0, cfg->samples - ph->rx_frames);
+        phase_free(ph);
+    }
+
+    return 0;
+}
+
+static int run_batch(const bench_config_t *cfg) {
+    int sizes[] = { 1, cfg->batch };
+    int runs = (cfg->batch > 1) ? 2 : 1;
+    const char *perf_names[] = { "RX batch 1 (recvmsg + callback)",
+                                 "RX batch -b (recvmmsg + callbacks)" };
+    phase_t *phases[2] = { NULL, NULL };
+
+    printf("Mode: batch, %d frames at %d µs per frame\n\n", cfg->samples, cfg->period_us);
+    printf("%-7s %-14s %-14s %-14s %-10s %-10s\n",
+           "Batch", "TX ns/frame", "RX ns/frame", "Frames/recv", "Avg µs", "P99 µs");
+    printf("-------------------------------------------------------------------------\n");
+
+    for (int i = 0; i < runs; i++) {
+        int batch = sizes[i];
+        phase_t *ph = phase_alloc(cfg->samples);
+        if (cfg->perf) {
+            ph->perf_name = perf_names[i];
+        }
+        uint64_t tx_cost, elapsed;
+        if (run_phase(cfg, ph, (uint64_t)cfg->period_us * 1000ULL * batch, batch,
+                      &tx_cost, &elapsed) < 0) {
+            phase_free(ph);
+            if (phases[0]) {
+                phase_free(phases[0]);
+            }
+            return 1;
+        }
+
+        bench_stats_t s;
+        bench_stats_compute(ph->latencies, ph->latency_count, &s);
+        printf("%-7d %-14lu %-14lu %-14.2f %-10.2f %-10.2f\n",
+               batch, (unsigned long)tx_cost,
+               (unsigned long)(ph->rx_frames ? ph->rx_busy_ns / ph->rx_frames : 0),
+               ph->rx_syscalls ? (double)ph->rx_frames / ph->rx_syscalls : 0.0,
+               s.avg_ns / 1000.0, s.p99_ns / 1000.0);
+        phases[i] = ph;  // kept for the counter reports below the table
+    }
+
+    for (int i = 0; i < runs; i++) {
+        if (phases[i]->perf_rx.name) {
+            bench_perf_report(&phases[i]->perf_rx);
+        }
+        phase_free(phases[i]);
+    }
+
+    return 0;
+}
+
+static int parse_levels(const char *arg, bench_config_t *cfg) {
+    char buf[128];
+    strncpy(buf, arg, sizeof(buf) - 1);
+    buf[sizeof(buf) - 1] = '\0';
+
+    cfg->load_count = 0;
+    for (char *tok = strtok(buf, ","); tok && cfg->load_count < MAX_LOAD_LEVELS;
+         tok = strtok(NULL, ",")) {
+        int level = atoi(tok);
+        if (level <= 0 || level > 100) {
+            fprintf(stderr, "Bus load level must be 1..100: %s\n", tok);
+            return -1;
+        }
+        cfg->load_levels[cfg->load_count++] = level;
+    }
+    return cfg->load_count > 0 ? 0 : -1;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Usage: %s [-i ifname] [-m latency|busload|batch] [-n samples]\n"
+            "          [-p period_us] [-b batch] [-l 10,30,50,70,90]\n"
+            "          [-r nominal:data] [-t] [-P] [-o csv]\n"
+            "  -i  CAN-FD interface (default %s)\n"
+            "  -m  measurement mode (default latency)\n"
+            "  -n  frames per phase (default %d)\n"
+            "  -p  TX period in µs (default %d)\n"
+            "  -b  sendmmsg/recvmmsg batch size for batch mode (max %d)\n"
+            "  -l  bus load levels in percent for busload mode; background\n"
+            "      frames on a lower CAN ID fill what -p leaves of each level\n"
+            "  -r  nominal:data bitrate (default %d:%d)\n"
+            "  -t  enable kernel RX timestamps (SO_TIMESTAMPING); hardware\n"
+            "      stamps are only counted, to show controller support\n"
+            "  -P  hardware counters around RX handling (latency, batch)\n"
+            "  -o  write raw latencies to CSV\n",
+            prog, DEFAULT_IFNAME, DEFAULT_SAMPLES, DEFAULT_PERIOD_US, MAX_BATCH,
+            NOMINAL_BITRATE, DATA_BITRATE);
+}
+
+int main(int argc, char **argv) {
+    bench_config_t cfg = {
+        .ifname = DEFAULT_IFNAME,
+        .mode = MODE_LATENCY,
+        .samples = DEFAULT_SAMPLES,
+        .period_us = DEFAULT_PERIOD_US,
+        .batch = 16,
+        .nominal_bitrate = NOMINAL_BITRATE,
+        .data_bitrate = DATA_BITRATE,
+    };
+    parse_levels("10,30,50,70,90", &cfg);
+
+    int opt;
+    while ((opt = getopt(argc, argv, "i:m:n:p:b:l:r:tPo:h")) != -1) {
+        switch (opt) {
+        case 'i': cfg.ifname = optarg; break;
+        case 'm':
+            if (strcmp(optarg, "latency") == 0) cfg.mode = MODE_LATENCY;
+            else if (strcmp(optarg, "busload") == 0) cfg.mode = MODE_BUSLOAD;
+            else if (strcmp(optarg, "batch") == 0) cfg.mode = MODE_BATCH;
+            else { usage(argv[0]); return 1; }
+            break;
+        case 'n': cfg.samples = atoi(optarg); break;
+        case 'p': cfg.period_us = atoi(optarg); break;
+        case 'b': cfg.batch = atoi(optarg); break;
+        case 'l':
+            if (parse_levels(optarg, &cfg) < 0) return 1;
+            break;
+        case 'r':
+            if (sscanf(optarg, "%d:%d", &cfg.nominal_bitrate, &cfg.data_bitrate) != 2) {
+                usage(argv[0]);
+                return 1;
+            }
+            break;
+        case 't': cfg.kernel_ts = 1; break;
+        case 'P': cfg.perf = 1; break;
+        case 'o': cfg.csv_path = optarg; break;
+        default: usage(argv[0]); return 1;
+        }
+    }
+
+    if (cfg.samples <= 0 || cfg.period_us < 0 || cfg.batch < 1 || cfg.batch > MAX_BATCH ||
+        cfg.nominal_bitrate <= 0 || cfg.data_bitrate <= 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    printf("=== Linux SocketCAN CAN-FD Benchmark ===\n");
+    printf("Interface: %s, CAN ID 0x%03X, %d-byte frames\n",
+           cfg.ifname, SENSOR_CAN_ID, SENSOR_FRAME_LEN);
+
+    switch (cfg.mode) {
+    case MODE_BUSLOAD: return run_busload(&cfg);
+    case MODE_BATCH: return run_batch(&cfg);
+    default: return run_latency(&cfg);
+    }
+}
@@ -0,0 +1,292 @@
+/*
+ * SOME/IP over UDP Publisher (Linux, no vendor stack)
+ * Offers the SensorEvent service via the SOME/IP-SD stand-in in
+ * someip_udp.h and publishes serialized SensorData notifications at 1kHz,
+ * optionally batching datagrams with sendmmsg. -P adds hardware counters
+ * for the serialize and send regions (bench_perf.h).
+ * Runs over loopback or across veth namespaces (see setup_veth_ns.sh).
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <getopt.h>
+#include <poll.h>
+#include <time.h>
+#include "bench_perf.h"
+#include "bench_rt.h"
+#include "bench_stats.h"
+#include "sensor_types.h"
+#include "someip_udp.h"
+
+#define SERVICE_ID 0x1234  // same ids as autosar_someip_pub.c
+#define INSTANCE_ID 0x0001
+#define EVENTGROUP_ID 0x0001
+#define EVENT_ID 0x8001
+#define DEFAULT_DATA_PORT 30501
+#define DEFAULT_RATE_HZ 1000
+#define DEFAULT_SAMPLES 10000
+#define MAX_BATCH 64
+#define MSG_SIZE (SOMEIP_HEADER_SIZE + StampedSensorData_t_SOMEIP_SIZE)
+
+typedef struct {
+    const char *bind_ip;
+    const char *sd_peer;   // where OfferService is sent
+    uint16_t data_port;
+    int rate_hz;
+    int samples;           // 0 = run forever
+    int batch;
+    int perf;
+} pub_config_t;
+
+static uint16_t next_session(uint16_t *session) {
+    if (++*session == 0) {
+        *session = 1;  // session id 0 means "not used"
+    }
+    return *session;
+}
+
+static void send_sd(int sd_fd, const struct sockaddr_in *to, uint16_t *session,
+                    const someip_sd_entry_t *e) {
+    uint8_t buf[SOMEIP_SD_MSG_SIZE];
+    size_t len = someip_sd_build(buf, next_session(session), e);
+    sendto(sd_fd, buf, len, 0, (const struct sockaddr *)to, sizeof(*to));
+}
+
+/*
+ * Offer once per second until a SubscribeEventgroup for our eventgroup
+ * arrives; acknowledge it and return the subscriber's data endpoint.
+ */
+static int wait_for_subscriber(int sd_fd, const pub_config_t *cfg,
+                               struct sockaddr_in *subscriber) {
+    struct sockaddr_in peer = {
+        .sin_family = AF_INET,
+        .sin_port = htons(SOMEIP_SD_CLIENT_PORT),
+    };
+    if (inet_pton(AF_INET, cfg->sd_peer, &peer.sin_addr) != 1) {
+        fprintf(stderr, "Invalid SD peer address: %s\n", cfg->sd_peer);
+        return -1;
+    }
+
+    someip_sd_entry_t offer = {
+        .type = SOMEIP_SD_OFFER_SERVICE,
+        .service_id = SERVICE_ID,
+        .instance_id = INSTANCE_ID,
+        .major_version = 1,
+        .ttl = SOMEIP_SD_TTL_S,
+        .minor_version = 0,
+        .ipv4 = someip_udp_local_ip_for(ntohl(peer.sin_addr.s_addr), SOMEIP_SD_CLIENT_PORT),
+        .port = cfg->data_port,
+    };
+    uint16_t session = 0;
+
+    printf("Offering service 0x%04X to %s:%d\n", SERVICE_ID, cfg->sd_peer,
+           SOMEIP_SD_CLIENT_PORT);
+
+    while (1) {
+        send_sd(sd_fd, &peer, &session, &offer);
+
+        struct pollfd pfd = { .fd = sd_fd, .events = POLLIN };
+        if (poll(&pfd, 1, 1000) <= 0) {
+            continue;
+        }
+
+        uint8_t buf[512];
+        struct sockaddr_in from;
+        socklen_t from_len = sizeof(from);
+        ssize_t n = recvfrom(sd_fd, buf, sizeof(buf), 0, (struct sockaddr *)&from, &from_len);
+        someip_sd_entry_t req;
+        if (n < 0 || someip_sd_parse(buf, n, &req) < 0 ||
+            req.type != SOMEIP_SD_SUBSCRIBE_EVENTGROUP || req.service_id != SERVICE_ID ||
+            req.eventgroup_id != EVENTGROUP_ID) {
+            continue;
+        }
+
+        someip_sd_entry_t ack = req;
+        ack.type = SOMEIP_SD_SUBSCRIBE_ACK;
+        ack.ipv4 = offer.ipv4;
+        ack.port = cfg->data_port;
+        send_sd(sd_fd, &from, &session, &ack);
+
+        memset(subscriber, 0, sizeof(*subscriber));
+        subscriber->sin_family = AF_INET;
+        subscriber->sin_addr.s_addr = htonl(req.ipv4);
+        subscriber->sin_port = htons(req.port);
+
+        char ip[INET_ADDRSTRLEN];
+        inet_ntop(AF_INET, &subscriber->sin_addr, ip, sizeof(ip));
+        printf("Subscriber %s:%u on eventgroup 0x%04X\n", ip, req.port, EVENTGROUP_ID);
+        return 0;
+    }
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Usage: %s [-b bind_ip] [-d sd_peer] [-p data_port] [-r rate_hz]\n"
+            "          [-n samples] [-B batch] [-P]\n"
+            "  -b  local address (default 0.0.0.0)\n"
+            "  -d  subscriber address for OfferService (default 127.0.0.1)\n"
+            "  -p  UDP port for notifications (default %d)\n"
+            "  -r  publish rate in Hz (default %d)\n"
+            "  -n  samples to publish, 0 = forever (default %d)\n"
+            "  -B  datagrams per sendmmsg (default 1, max %d)\n"
+            "  -P  report hardware counters for serialize and send\n",
+            prog, DEFAULT_DATA_PORT, DEFAULT_RATE_HZ, DEFAULT_SAMPLES, MAX_BATCH);
+}
+
+int main(int argc, char **argv) {
+    pub_config_t cfg = {
+        .bind_ip = "0.0.0.0",
+        .sd_peer = "127.0.0.1",
+        .data_port = DEFAULT_DATA_PORT,
+        .rate_hz = DEFAULT_RATE_HZ,
+        .samples = DEFAULT_SAMPLES,
+        .batch = 1,
+    };
+
+    int opt;
+    while ((opt = getopt(argc, argv, "b:d:p:r:n:B:Ph")) != -1) {
+        switch (opt) {
+        case 'b': cfg.bind_ip = optarg; break;
+        case 'd': cfg.sd_peer = optarg; break;
+        case 'p': cfg.data_port = (uint16_t)atoi(optarg); break;
+        case 'r': cfg.rate_hz = atoi(optarg); break;
+        case 'n': cfg.samples = atoi(optarg); break;
+        case 'B': cfg.batch = atoi(optarg); break;
+        case 'P': cfg.perf = 1; break;
+        default: usage(argv[0]); return 1;
+        }
+    }
+    if (cfg.rate_hz <= 0 || cfg.samples < 0 || cfg.batch < 1 || cfg.batch > MAX_BATCH) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    printf("=== Linux SOME/IP-over-UDP Publisher ===\n");
+
+    int sd_fd = someip_udp_socket(cfg.bind_ip, SOMEIP_SD_PORT);
+    int data_fd = someip_udp_socket(cfg.bind_ip, cfg.data_port);
+    if (sd_fd < 0 || data_fd < 0) {
+        return 1;
+    }
+
+    struct sockaddr_in subscriber;
+    if (wait_for_subscriber(sd_fd, &cfg, &subscriber) < 0) {
+        return 1;
+    }
+    if (connect(data_fd, (struct sockaddr *)&subscriber, sizeof(subscriber)) < 0) {
+        perror("connect(subscriber)");
+        return 1;
+    }
+
+    printf("Publishing at %d Hz, batch %d\n", cfg.rate_hz, cfg.batch);
+    printf("Press Ctrl+C to stop\n\n");
+
+    static uint8_t bufs[MAX_BATCH][MSG_SIZE];
+    struct iovec iov[MAX_BATCH];
+    struct mmsghdr msgs[MAX_BATCH];
+    for (int i = 0; i < MAX_BATCH; i++) {
+        iov[i].iov_base = bufs[i];
+        iov[i].iov_len = MSG_SIZE;
+        memset(&msgs[i], 0, sizeof(msgs[i]));
+        msgs[i].msg_hdr.msg_iov = &iov[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    bench_perf_region_t perf_serialize, perf_send;
+    if (cfg.perf) {
+        bench_perf_open_flags(&perf_serialize, "serialize (header + encode)",
+                              BENCH_PERF_USER_ONLY);  // no syscalls inside
+        bench_perf_open(&perf_send, cfg.batch > 1 ? "send (sendmmsg)" : "send (send)");
+    }
+
+    uint64_t period_ns = 1000000000ULL / cfg.rate_hz;
+    uint64_t serialize_ns = 0, send_ns = 0;
+    uint32_t seq = 0, dropped = 0;
+    uint16_t session = 0;
+    uint64_t next = bench_now_ns(CLOCK_MONOTONIC);
+
+    while (cfg.samples == 0 || seq < (uint32_t)cfg.samples) {
+        int n = cfg.batch;
+        if (cfg.samples && seq + n > (uint32_t)cfg.samples) {
+            n = cfg.samples - seq;
+        }
+
+        if (cfg.perf) bench_perf_begin(&perf_serialize);
+        for (int i = 0; i < n; i++) {
+            uint64_t t0 = bench_now_ns(CLOCK_MONOTONIC);
+            StampedSensorData_t sample;
+            sample.tx_ns = t0;
+            sample.data.timestamp_us = t0 / 1000;
+            sample.data.imu_accel_x = 0.1f * seq;
+            sample.data.imu_accel_y = 0.2f * seq;
+            sample.data.imu_accel_z = 9.8f;
+            sample.data.sequence = seq++;
+
+            someip_header_t h = {
+                .service_id = SERVICE_ID,
+                .method_id = EVENT_ID,
+                .length = SOMEIP_LENGTH_COVERED + StampedSensorData_t_SOMEIP_SIZE,
+                .client_id = 0,
+                .session_id = next_session(&session),
+                .protocol_version = SOMEIP_PROTOCOL_VERSION,
+                .interface_version = 1,
+                .message_type = SOMEIP_MSG_NOTIFICATION,
+                .return_code = SOMEIP_E_OK,
+            };
+            someip_header_put(bufs[i], &h);
+            StampedSensorData_t_someip_encode(&sample, bufs[i] + SOMEIP_HEADER_SIZE);
+            serialize_ns += bench_now_ns(CLOCK_MONOTONIC) - t0;
+        }
+        if (cfg.perf) bench_perf_end(&perf_serialize, n);
+
+        if (cfg.perf) bench_perf_begin(&perf_send);
+        uint64_t s0 = bench_now_ns(CLOCK_MONOTONIC);
+        int done = 0, sent = 0;
+        while (done < n) {  // sendmmsg may stop short of the batch
+            sent = (n - done > 1)
+                       ? sendmmsg(data_fd, msgs + done, n - done, 0)
+                       : (send(data_fd, bufs[done], MSG_SIZE, 0) == MSG_SIZE ? 1 : -1);
+            if (sent < 0 && errno == EINTR) continue;
+            if (sent <= 0) break;
+            done += sent;
+        }
+        send_ns += bench_now_ns(CLOCK_MONOTONIC) - s0;
+        if (cfg.perf) bench_perf_end(&perf_send, done);
+        // seq already counts these samples, so the subscriber sees a gap
+        dropped += n - done;
+        if (sent < 0 && errno != ECONNREFUSED) {
+            perror("send(notification)");
+            break;
+        }
+
+        if (seq % 1000 < (uint32_t)n) {
+            printf("Published %u samples\n", seq);
+        }
+
+        next += period_ns * n;
+        bench_sleep_until(next);
+    }
+
+    printf("\nPublisher cost per message:\n");
+    printf("  Serialize: %.1f ns\n", seq ? (double)serialize_ns / seq : 0.0);
+    printf("  Send:      %.1f ns (batch %d)\n", seq ? (double)send_ns / seq : 0.0, cfg.batch);
+    if (dropped) {
+        printf("⚠ Publisher drops: %u of %u samples not sent\n", dropped, seq);
+    }
+
+    if (cfg.perf) {
+        bench_perf_report(&perf_serialize);
+        bench_perf_report(&perf_send);
+        bench_perf_close(&perf_serialize);
+        bench_perf_close(&perf_send);
+    }
+
+    close(data_fd);
+    close(sd_fd);
+    return 0;
+}
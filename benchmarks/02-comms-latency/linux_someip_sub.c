@@ -0,0 +1,404 @@
+/*
+ * SOME/IP over UDP Subscriber (Linux, no vendor stack)
+ * Subscribes through the SOME/IP-SD stand-in and splits end-to-end latency
+ * at the kernel RX timestamp, so network-stack and middleware cost can be
+ * told apart:
+ *   stack      publisher send stamp -> kernel RX stamp
+ *   wakeup     kernel RX stamp      -> recvmmsg returns
+ *   middleware recvmmsg returns     -> callback (header check + decode)
+ * Receive modes: blocking recvmmsg, epoll, or busy-poll (SO_BUSY_POLL).
+ * -P adds hardware counters around recvmmsg + callbacks (bench_perf.h). The
+ * counter enable runs after the kernel RX stamp of an already queued
+ * message, so with -P the socket wakeup component is not reported and E2E
+ * includes the enable; stack and middleware components are unaffected.
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <getopt.h>
+#include <sys/epoll.h>
+#include <poll.h>
+#include <time.h>
+#include "bench_perf.h"
+#include "bench_stats.h"
+#include "sensor_types.h"
+#include "someip_udp.h"
+
+#define SERVICE_ID 0x1234
+#define EVENTGROUP_ID 0x0001
+#define EVENT_ID 0x8001
+#define DEFAULT_DATA_PORT 30502
+#define DEFAULT_SAMPLES 10000
+#define IDLE_TIMEOUT_MS 2000
+#define BUSY_POLL_US 50
+#define MAX_BATCH 64
+#define RX_BUF_SIZE 1500
+
+typedef enum {
+    RX_BLOCK,
+    RX_EPOLL,
+    RX_BUSY,
+} rx_mode_t;
+
+static const char *rx_mode_names[] = { "block", "epoll", "busy" };
+
+typedef struct {
+    const char *bind_ip;
+    uint16_t data_port;
+    rx_mode_t mode;
+    int batch;
+    int samples;
+    const char *hw_ifname;
+    const char *csv_path;
+    int perf;
+} sub_config_t;
+
+typedef struct {
+    uint64_t *e2e;
+    uint64_t *stack;
+    uint64_t *wakeup;
+    uint64_t *middleware;
+    int count;
+    int stamp_count;
+    bench_perf_region_t perf_rx;
+    int hw_stamp_count;
+    int bad_messages;
+    uint32_t last_seq;
+    int gaps;
+    uint64_t syscalls;
+} rx_results_t;
+
+/*
+ * Wait for an OfferService of our service, subscribe with our data
+ * endpoint and wait for the acknowledgement.
+ */
+static int subscribe(int sd_fd, const sub_config_t *cfg) {
+    printf("Waiting for OfferService 0x%04X on port %d\n", SERVICE_ID, SOMEIP_SD_CLIENT_PORT);
+    uint16_t session = 0;
+
+    while (1) {
+        uint8_t buf[512];
+        struct sockaddr_in from;
+        socklen_t from_len = sizeof(from);
+        ssize_t n = recvfrom(sd_fd, buf, sizeof(buf), 0, (struct sockaddr *)&from, &from_len);
+        someip_sd_entry_t e;
+        if (n < 0 || someip_sd_parse(buf, n, &e) < 0 || e.service_id != SERVICE_ID) {
+            continue;
+        }
+
+        if (e.type == SOMEIP_SD_OFFER_SERVICE) {
+            someip_sd_entry_t req = {
+                .type = SOMEIP_SD_SUBSCRIBE_EVENTGROUP,
+                .service_id = SERVICE_ID,
+                .instance_id = e.instance_id,
+                .major_version = e.major_version,
+                .ttl = SOMEIP_SD_TTL_S,
+                .eventgroup_id = EVENTGROUP_ID,
+                .ipv4 = someip_udp_local_ip_for(ntohl(from.sin_addr.s_addr),
+                                                ntohs(from.sin_port)),
+                .port = cfg->data_port,
+            };
+            if (++session == 0) {
+                session = 1;
+            }
+            size_t len = someip_sd_build(buf, session, &req);
+            sendto(sd_fd, buf, len, 0, (struct sockaddr *)&from, sizeof(from));
+        } else if (e.type == SOMEIP_SD_SUBSCRIBE_ACK && e.eventgroup_id == EVENTGROUP_ID) {
+            if (e.ttl == 0) {
+                fprintf(stderr, "Subscription rejected (NACK)\n");
+                return -1;
+            }
+            printf("Subscribed to eventgroup 0x%04X\n", EVENTGROUP_ID);
+            return 0;
+        }
+    }
+}
+
+/* Notification callback: the point where the application sees the sample */
+static void on_message(rx_results_t *r, const uint8_t *buf, size_t len,
+                       uint64_t recv_ns, uint64_t kernel_ns, int samples) {
+    someip_header_t h;
+    StampedSensorData_t sample;
+
+    if (len < SOMEIP_HEADER_SIZE) {
+        r->bad_messages++;
+        return;
+    }
+    someip_header_get(buf, &h);
+    if (h.service_id != SERVICE_ID || h.method_id != EVENT_ID ||
+        h.message_type != SOMEIP_MSG_NOTIFICATION ||
+        h.length != SOMEIP_LENGTH_COVERED + len - SOMEIP_HEADER_SIZE ||
+        StampedSensorData_t_someip_decode(buf + SOMEIP_HEADER_SIZE,
+                                          len - SOMEIP_HEADER_SIZE, &sample) < 0) {
+        r->bad_messages++;
+        return;
+    }
+
+    uint64_t now = bench_now_ns(CLOCK_MONOTONIC);
+    if (r->count >= samples) {
+        return;
+    }
+
+    if (r->count > 0 && sample.data.sequence != r->last_seq + 1) {
+        r->gaps++;
+    }
+    r->last_seq = sample.data.sequence;
+
+    r->e2e[r->count] = now - sample.tx_ns;
+    r->middleware[r->count] = now - recv_ns;
+    r->count++;
+
+    if (kernel_ns && kernel_ns >= sample.tx_ns && recv_ns >= kernel_ns) {
+        r->stack[r->stamp_count] = kernel_ns - sample.tx_ns;
+        r->wakeup[r->stamp_count] = recv_ns - kernel_ns;
+        r->stamp_count++;
+    }
+
+    if (sample.data.sequence % 1000 == 0) {
+        printf("Received seq %u, E2E latency: %.2f µs\n",
+               sample.data.sequence, (now - sample.tx_ns) / 1000.0);
+    }
+}
+
+static int receive_loop(int fd, const sub_config_t *cfg, rx_results_t *r) {
+    static uint8_t bufs[MAX_BATCH][RX_BUF_SIZE];
+    static char ctrl[MAX_BATCH][CMSG_SPACE(sizeof(struct scm_timestamping))];
+    struct iovec iov[MAX_BATCH];
+    struct mmsghdr msgs[MAX_BATCH];
+
+    int ep = -1;
+    if (cfg->mode == RX_EPOLL) {
+        ep = epoll_create1(0);
+        struct epoll_event ev = { .events = EPOLLIN, .data.fd = fd };
+        epoll_ctl(ep, EPOLL_CTL_ADD, fd, &ev);
+    }
+
+    uint64_t idle_since = bench_now_ns(CLOCK_MONOTONIC);
+    while (r->count < cfg->samples) {
+        if (cfg->mode == RX_EPOLL) {
+            struct epoll_event ev;
+            int ready = epoll_wait(ep, &ev, 1, IDLE_TIMEOUT_MS);
+            if (ready == 0) {
+                break;
+            }
+            if (ready < 0) {
+                if (errno == EINTR) continue;
+                perror("epoll_wait");
+                break;
+            }
+        }
+
+        if (cfg->mode == RX_BUSY) {
+            // Spin outside the -P region, so it covers only non-empty receives
+            struct pollfd pfd = { .fd = fd, .events = POLLIN };
+            int ready = poll(&pfd, 1, 0);
+            if (ready < 0 && errno != EINTR) {
+                perror("poll");
+                break;
+            }
+            if (ready <= 0) {
+                if (bench_now_ns(CLOCK_MONOTONIC) - idle_since > IDLE_TIMEOUT_MS * 1000000ULL) {
+                    break;  // busy-poll idle timeout
+                }
+                continue;
+            }
+        }
+
+        for (int i = 0; i < cfg->batch; i++) {
+            iov[i].iov_base = bufs[i];
+            iov[i].iov_len = RX_BUF_SIZE;
+            memset(&msgs[i], 0, sizeof(msgs[i]));
+            msgs[i].msg_hdr.msg_iov = &iov[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+            msgs[i].msg_hdr.msg_control = ctrl[i];
+            msgs[i].msg_hdr.msg_controllen = sizeof(ctrl[i]);
+        }
+
+        if (cfg->perf) bench_perf_begin(&r->perf_rx);
+        int flags = (cfg->mode == RX_BLOCK) ? MSG_WAITFORONE : MSG_DONTWAIT;
+        int n = recvmmsg(fd, msgs, cfg->batch, flags, NULL);
+        uint64_t recv_ns = bench_now_ns(CLOCK_MONOTONIC);
+
+        if (n <= 0) {
+            if (cfg->perf) bench_perf_end(&r->perf_rx, 0);
+            if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                perror("recvmmsg");
+                break;
+            }
+            if (cfg->mode == RX_BLOCK ||
+                recv_ns - idle_since > IDLE_TIMEOUT_MS * 1000000ULL) {
+                break;  // SO_RCVTIMEO or busy-poll idle timeout
+            }
+            continue;
+        }
+        r->syscalls++;
+        idle_since = recv_ns;
+
+        /* Kernel stamps are CLOCK_REALTIME; map them onto CLOCK_MONOTONIC */
+        int64_t real_to_mono = (int64_t)recv_ns - (int64_t)bench_now_ns(CLOCK_REALTIME);
+
+        for (int i = 0; i < n; i++) {
+            uint64_t kernel_ns = 0;
+            const struct scm_timestamping *ts = someip_udp_rx_stamps(&msgs[i].msg_hdr);
+            if (ts && (ts->ts[0].tv_sec || ts->ts[0].tv_nsec)) {
+                kernel_ns = (uint64_t)((int64_t)bench_timespec_ns(&ts->ts[0]) + real_to_mono);
+            }
+            // Raw NIC stamps are in the PHC domain, not CLOCK_MONOTONIC, so
+            // without PTP they cannot be split against tx_ns; only counted
+            if (ts && (ts->ts[2].tv_sec || ts->ts[2].tv_nsec)) {
+                r->hw_stamp_count++;
+            }
+            on_message(r, bufs[i], msgs[i].msg_len, recv_ns, kernel_ns, cfg->samples);
+        }
+        if (cfg->perf) bench_perf_end(&r->perf_rx, n);
+    }
+
+    if (ep >= 0) {
+        close(ep);
+    }
+    return 0;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Usage: %s [-b bind_ip] [-p data_port] [-m block|epoll|busy] [-B batch]\n"
+            "          [-n samples] [-H ifname] [-o csv] [-P]\n"
+            "  -b  local address (default 0.0.0.0)\n"
+            "  -p  UDP port for notifications (default %d)\n"
+            "  -m  receive mode (default block)\n"
+            "  -B  datagrams per recvmmsg (default 1, max %d)\n"
+            "  -n  samples to collect (default %d)\n"
+            "  -H  enable hardware RX timestamps on ifname; they are only\n"
+            "      counted, to show NIC support (the split uses software stamps)\n"
+            "  -o  write raw E2E latencies to CSV\n"
+            "  -P  report hardware counters for receive + callback\n"
+            "      (in block mode the region includes waiting in recvmmsg)\n",
+            prog, DEFAULT_DATA_PORT, MAX_BATCH, DEFAULT_SAMPLES);
+}
+
+int main(int argc, char **argv) {
+    sub_config_t cfg = {
+        .bind_ip = "0.0.0.0",
+        .data_port = DEFAULT_DATA_PORT,
+        .mode = RX_BLOCK,
+        .batch = 1,
+        .samples = DEFAULT_SAMPLES,
+    };
+
+    int opt;
+    while ((opt = getopt(argc, argv, "b:p:m:B:n:H:o:Ph")) != -1) {
+        switch (opt) {
+        case 'b': cfg.bind_ip = optarg; break;
+        case 'p': cfg.data_port = (uint16_t)atoi(optarg); break;
+        case 'm':
+            if (strcmp(optarg, "block") == 0) cfg.mode = RX_BLOCK;
+            else if (strcmp(optarg, "epoll") == 0) cfg.mode = RX_EPOLL;
+            else if (strcmp(optarg, "busy") == 0) cfg.mode = RX_BUSY;
+            else { usage(argv[0]); return 1; }
+            break;
+        case 'B': cfg.batch = atoi(optarg); break;
+        case 'n': cfg.samples = atoi(optarg); break;
+        case 'H': cfg.hw_ifname = optarg; break;
+        case 'o': cfg.csv_path = optarg; break;
+        case 'P': cfg.perf = 1; break;
+        default: usage(argv[0]); return 1;
+        }
+    }
+    if (cfg.samples <= 0 || cfg.batch < 1 || cfg.batch > MAX_BATCH) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    printf("=== Linux SOME/IP-over-UDP Subscriber ===\n");
+    printf("Receive mode: %s, batch %d\n", rx_mode_names[cfg.mode], cfg.batch);
+
+    int sd_fd = someip_udp_socket(cfg.bind_ip, SOMEIP_SD_CLIENT_PORT);
+    int data_fd = someip_udp_socket(cfg.bind_ip, cfg.data_port);
+    if (sd_fd < 0 || data_fd < 0) {
+        return 1;
+    }
+
+    someip_udp_enable_timestamps(data_fd, cfg.hw_ifname);
+    int rcvbuf = 4 * 1024 * 1024;
+    setsockopt(data_fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+    if (cfg.mode == RX_BLOCK) {
+        struct timeval tv = { .tv_sec = IDLE_TIMEOUT_MS / 1000, .tv_usec = 0 };
+        setsockopt(data_fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    } else if (cfg.mode == RX_BUSY) {
+        int busy_us = BUSY_POLL_US;
+        if (setsockopt(data_fd, SOL_SOCKET, SO_BUSY_POLL, &busy_us, sizeof(busy_us)) < 0) {
+            perror("SO_BUSY_POLL (spinning in user space only)");
+        }
+    }
+
+    if (subscribe(sd_fd, &cfg) < 0) {
+        return 1;
+    }
+    printf("Listening on port %u\n\n", cfg.data_port);
+
+    rx_results_t r = {
+        .e2e = calloc(cfg.samples, sizeof(uint64_t)),
+        .stack = calloc(cfg.samples, sizeof(uint64_t)),
+        .wakeup = calloc(cfg.samples, sizeof(uint64_t)),
+        .middleware = calloc(cfg.samples, sizeof(uint64_t)),
+    };
+    if (!r.e2e || !r.stack || !r.wakeup || !r.middleware) {
+        fprintf(stderr, "Out of memory for %d samples\n", cfg.samples);
+        return 1;
+    }
+
+    if (cfg.perf) {
+        bench_perf_open(&r.perf_rx, "receive (recvmmsg + callback)");
+    }
+    receive_loop(data_fd, &cfg, &r);
+
+    bench_stats_t s;
+    bench_stats_compute(r.e2e, r.count, &s);
+    bench_stats_print("E2E Latency Statistics", &s);
+    printf("  Gaps:   %d, malformed: %d\n", r.gaps, r.bad_messages);
+    printf("  Msgs per recvmmsg: %.2f\n", r.syscalls ? (double)r.count / r.syscalls : 0.0);
+
+    if (r.stamp_count > 0) {
+        bench_stats_t part;
+        bench_stats_compute(r.stack, r.stamp_count, &part);
+        bench_stats_print("Network stack (send → kernel RX stamp)", &part);
+        if (cfg.perf) {
+            printf("\n⚠ Socket wakeup not shown with -P (counter enable runs inside it)\n");
+        } else {
+            bench_stats_compute(r.wakeup, r.stamp_count, &part);
+            bench_stats_print("Socket wakeup (kernel RX stamp → recvmmsg)", &part);
+        }
+    } else {
+        printf("\n⚠ No kernel RX timestamps received\n");
+    }
+    bench_stats_t mw;
+    bench_stats_compute(r.middleware, r.count, &mw);
+    bench_stats_print("Middleware (recvmmsg → callback)", &mw);
+    if (cfg.hw_ifname) {
+        printf("  Hardware RX stamps: %d of %d messages\n", r.hw_stamp_count, r.count);
+    }
+    printf("\n");
+
+    if (cfg.perf) {
+        bench_perf_report(&r.perf_rx);
+        bench_perf_close(&r.perf_rx);
+        printf("\n");
+    }
+    if (cfg.csv_path) {
+        bench_stats_save_csv(cfg.csv_path, r.e2e, r.count);
+    }
+    int pass = bench_stats_verdict(&s, 1000);
+
+    free(r.e2e);
+    free(r.stack);
+    free(r.wakeup);
+    free(r.middleware);
+    close(data_fd);
+    close(sd_fd);
+    return pass ? 0 : 2;
+}
@@ -0,0 +1,18 @@
+#!/bin/bash
+# Create a virtual CAN-FD interface for linux_canfd_bench (requires root)
+# Real hardware instead:
+#   ip link set can0 type can bitrate 500000 dbitrate 2000000 fd on
+#   ip link set can0 up
+
+set -e
+
+IFNAME=${1:-vcan0}
+
+modprobe vcan
+if ! ip link show "$IFNAME" > /dev/null 2>&1; then
+    ip link add dev "$IFNAME" type vcan
+fi
+ip link set "$IFNAME" mtu 72  # CANFD_MTU
+ip link set "$IFNAME" up
+
+echo "✓ $IFNAME ready (CAN-FD, mtu 72)"
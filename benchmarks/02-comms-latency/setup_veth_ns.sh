@@ -0,0 +1,37 @@
+#!/bin/bash
+# Two network namespaces joined by a veth pair, for linux_someip_pub/sub
+# across a real (virtual) link instead of loopback (requires root)
+#
+#   sudo ./setup_veth_ns.sh
+#   sudo ip netns exec someip_sub ./linux_someip_sub -m busy &
+#   sudo ip netns exec someip_pub ./linux_someip_pub -d 10.77.0.2
+#
+#   sudo ./setup_veth_ns.sh teardown
+
+set -e
+
+PUB_NS=someip_pub
+SUB_NS=someip_sub
+
+if [ "$1" = "teardown" ]; then
+    ip netns del $PUB_NS 2>/dev/null || true
+    ip netns del $SUB_NS 2>/dev/null || true
+    echo "✓ Namespaces removed"
+    exit 0
+fi
+
+ip netns add $PUB_NS
+ip netns add $SUB_NS
+ip link add veth_pub type veth peer name veth_sub
+ip link set veth_pub netns $PUB_NS
+ip link set veth_sub netns $SUB_NS
+
+ip -n $PUB_NS addr add 10.77.0.1/24 dev veth_pub
+ip -n $SUB_NS addr add 10.77.0.2/24 dev veth_sub
+for ns in $PUB_NS $SUB_NS; do
+    ip -n $ns link set lo up
+done
+ip -n $PUB_NS link set veth_pub up
+ip -n $SUB_NS link set veth_sub up
+
+echo "✓ $PUB_NS (10.77.0.1) <-> $SUB_NS (10.77.0.2) ready"
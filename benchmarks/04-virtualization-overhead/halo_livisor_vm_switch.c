@@ -2,12 +2,15 @@
 /*
  * Halo OS LiVisor VM Switch Benchmark
  * Measures context switch time between RT and Linux VMs
+ * PMU counters around livisor_switch_vm show where the cycles go
+ * (cache/TLB refills after the switch vs. hypervisor path length)
  */
 
 #include 
 #include 
 #include 
 #include <livisor/livisor.h>
+#include "bench_perf.h"
 
 #define TEST_ITERATIONS 100000
 
@@ -28,6 +31,9 @@ int main(void) {
     livisor_vm_t *vm_linux = livisor_create_vm(LIVISOR_VM_TYPE_LINUX, 1);
     
     uint64_t total_cycles = 0;
+    bench_perf_region_t perf_switch;
+    bench_perf_open(&perf_switch, "livisor_switch_vm");
+    bench_perf_begin(&perf_switch);
     
     for (int i = 0; i < TEST_ITERATIONS; i++) {
         uint64_t start = rdtsc();
@@ -42,6 +48,8 @@ int main(void) {
         total_cycles += (end - start);
     }
     
+    bench_perf_end(&perf_switch, 2 * TEST_ITERATIONS);  // two switches per iteration
+    
     /* Convert to microseconds (assume 2 GHz CPU) */
     uint64_t avg_cycles = total_cycles / TEST_ITERATIONS;
     double avg_us = (double)avg_cycles / 2000.0;
@@ -57,6 +65,9 @@ int main(void) {
         printf("⚠ Higher than expected: %.2fµs\n", avg_us);
     }
     
+    bench_perf_report(&perf_switch);
+    bench_perf_close(&perf_switch);
+    
     return 0;
 }
 ```
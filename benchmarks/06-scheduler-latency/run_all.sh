@@ -0,0 +1,23 @@
+#!/bin/bash
+# Run the scheduler primitive benchmarks
+
+set -e
+
+echo "=== Scheduler Primitive Benchmark ==="
+echo ""
+
+make clean
+make linux
+
+mkdir -p ../../results/2025-11-benchmarks
+./schedbench_posix -o ../../results/2025-11-benchmarks/schedbench_summary.csv
+
+# Vendor backends need their toolchains and a target
+if [ "$RUN_MODE" = "hardware" ]; then
+    echo "Running on hardware..."
+    make schedbench_halo schedbench_qnx schedbench_autosar
+    t32marm -c ../../../boards/infineon-tc397/halo/config.t32 -s run_tests.cmm
+fi
+
+echo ""
+echo "✓ Tests complete. Results in ../../results/2025-11-benchmarks/"
@@ -0,0 +1,204 @@
+/*
+ * Scheduler Primitive Benchmark for AUTOSAR Classic (OSEK/VDX OS)
+ * ActivateTask dispatch and return, SetEvent/WaitEvent wakeup and
+ * priority-ceiling blocking with GetResource/ReleaseResource.
+ * OSEK has no blocking mutex, so the inversion baseline is the hand-rolled
+ * lock applications build without a resource: a busy flag plus an event
+ * High waits on. Medium preempts the flag holder and delays High by its
+ * whole run; the priority ceiling bounds that to the critical section.
+ *
+ * Required OIL objects (EB tresos style):
+ *   TASK SchedMainTask { PRIORITY = 2;  AUTOSTART = TRUE; SCHEDULE = FULL; }
+ *   TASK SchedActTask  { PRIORITY = 10; ACTIVATION = 1; SCHEDULE = FULL; }
+ *   TASK SchedWakeTask { PRIORITY = 10; AUTOSTART = TRUE; EVENT = SchedWakeEvent; }
+ *   TASK SchedHighTask { PRIORITY = 8;  RESOURCE = SchedRes; EVENT = SchedReleaseEvent; }
+ *   TASK SchedMedTask  { PRIORITY = 6; }
+ *   TASK SchedLowTask  { PRIORITY = 4;  RESOURCE = SchedRes; }
+ *   EVENT SchedWakeEvent; EVENT SchedDoneEvent; EVENT SchedReleaseEvent;
+ *   (SchedMainTask and SchedHighTask are extended)
+ *   RESOURCE SchedRes { RESOURCEPROPERTY = STANDARD; }   (ceiling = 8)
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include "Os.h"
+
+#define TEST_ITERATIONS 10000
+#define PI_ITERATIONS 200
+#define PI_CRITICAL_US 50
+#define PI_HOG_US 2000
+#define HIST_BUCKETS 32
+
+/* TC3xx STM0 free-running timer, 100 MHz */
+#define STM0_TIM0 (*(volatile uint32_t *)0xF0001010u)
+#define STM_NS_PER_TICK 10u
+
+static uint32_t samples[TEST_ITERATIONS];
+static volatile uint32_t t_start, t_end;
+static volatile int use_resource;
+static volatile int data_busy;  // hand-rolled lock for the baseline
+
+static inline uint32_t now_ticks(void) {
+    return STM0_TIM0;
+}
+
+static void spin_us(uint32_t us) {
+    uint32_t start = now_ticks();
+    while ((uint32_t)(now_ticks() - start) < us * (1000u / STM_NS_PER_TICK)) {
+    }
+}
+
+/* Min/avg/max plus a log2 histogram, no heap on the ECU */
+static void report(const char *name, const uint32_t *data, int count) {
+    uint32_t min = UINT32_MAX, max = 0, hist[HIST_BUCKETS] = { 0 };
+    uint64_t sum = 0;
+
+    for (int i = 0; i < count; i++) {
+        uint32_t ns = data[i] * STM_NS_PER_TICK;
+        if (ns < min) min = ns;
+        if (ns > max) max = ns;
+        sum += ns;
+        int b = ns ? 32 - __builtin_clz(ns) : 0;
+        hist[b < HIST_BUCKETS ? b : HIST_BUCKETS - 1]++;
+    }
+
+    printf("\n%s:\n", name);
+    printf("  Samples: %d\n", count);
+    printf("  Min:     %lu.%02lu µs\n", (unsigned long)(min / 1000), (unsigned long)(min % 1000 / 10));
+    printf("  Avg:     %lu.%02lu µs\n", (unsigned long)(sum / count / 1000),
+           (unsigned long)(sum / count % 1000 / 10));
+    printf("  Max:     %lu.%02lu µs\n", (unsigned long)(max / 1000), (unsigned long)(max % 1000 / 10));
+    printf("  Histogram (ns, upper bound):\n");
+    for (int b = 0; b < HIST_BUCKETS; b++) {
+        if (hist[b]) {
+            printf("    < %10lu: %lu\n", (unsigned long)(1UL << b), (unsigned long)hist[b]);
+        }
+    }
+}
+
+/* Preempts SchedMainTask as soon as it is activated */
+TASK(SchedActTask) {
+    t_end = now_ticks();
+    TerminateTask();
+}
+
+/* Extended task parked on SchedWakeEvent */
+TASK(SchedWakeTask) {
+    while (1) {
+        WaitEvent(SchedWakeEvent);
+        ClearEvent(SchedWakeEvent);
+        t_end = now_ticks();
+    }
+}
+
+TASK(SchedHighTask) {
+    if (use_resource) {
+        GetResource(SchedRes);
+        ReleaseResource(SchedRes);
+    } else {
+        while (data_busy) {
+            WaitEvent(SchedReleaseEvent);
+            ClearEvent(SchedReleaseEvent);
+        }
+    }
+    t_end = now_ticks();
+    TerminateTask();
+}
+
+TASK(SchedMedTask) {
+    spin_us(PI_HOG_US);
+    TerminateTask();
+}
+
+/* Activates High and Med from inside the critical section */
+TASK(SchedLowTask) {
+    if (use_resource) {
+        GetResource(SchedRes);
+    } else {
+        data_busy = 1;
+    }
+    t_start = now_ticks();
+    ActivateTask(SchedHighTask);
+    ActivateTask(SchedMedTask);
+    spin_us(PI_CRITICAL_US);
+    if (use_resource) {
+        ReleaseResource(SchedRes);
+    } else {
+        data_busy = 0;
+        SetEvent(SchedHighTask, SchedReleaseEvent);
+    }
+    SetEvent(SchedMainTask, SchedDoneEvent);
+    TerminateTask();
+}
+
+static void test_activate(void) {
+    static uint32_t back[TEST_ITERATIONS];
+
+    printf("\n--- ActivateTask dispatch ---\n");
+    for (int i = 0; i < TEST_ITERATIONS; i++) {
+        t_start = now_ticks();
+        ActivateTask(SchedActTask);
+        uint32_t t_back = now_ticks();
+        samples[i] = t_end - t_start;
+        back[i] = t_back - t_end;
+    }
+    report("activate/dispatch", samples, TEST_ITERATIONS);
+    report("activate/terminate_return", back, TEST_ITERATIONS);
+}
+
+static void test_event(void) {
+    printf("\n--- SetEvent wakeup ---\n");
+    for (int i = 0; i < TEST_ITERATIONS; i++) {
+        t_start = now_ticks();
+        SetEvent(SchedWakeTask, SchedWakeEvent);
+        samples[i] = t_end - t_start;
+    }
+    report("wakeup/set_event", samples, TEST_ITERATIONS);
+}
+
+static uint32_t run_resource(int with_resource, const char *name) {
+    uint32_t max = 0;
+
+    use_resource = with_resource;
+    for (int i = 0; i < PI_ITERATIONS; i++) {
+        ActivateTask(SchedLowTask);
+        WaitEvent(SchedDoneEvent);
+        ClearEvent(SchedDoneEvent);
+        samples[i] = t_end - t_start;
+        if (samples[i] > max) max = samples[i];
+    }
+    report(name, samples, PI_ITERATIONS);
+    return max * STM_NS_PER_TICK;
+}
+
+static void test_resource(void) {
+    printf("\n--- Priority ceiling (critical section %d µs, hog %d µs) ---\n",
+           PI_CRITICAL_US, PI_HOG_US);
+
+    uint32_t max_flag = run_resource(0, "pi/flag_lock");
+    uint32_t max_ceiling = run_resource(1, "pi/priority_ceiling");
+
+    printf("\n");
+    if (max_flag < PI_HOG_US * 1000u) {
+        printf("⚠ INCONCLUSIVE: Baseline never showed the inversion (max %lu µs < hog %d µs)\n",
+               (unsigned long)(max_flag / 1000), PI_HOG_US);
+    } else if (max_ceiling < (PI_CRITICAL_US + PI_HOG_US / 2) * 1000u) {
+        printf("✓ PASS: Ceiling bounds blocking to the critical section "
+               "(max %lu µs vs %lu µs with a flag lock)\n",
+               (unsigned long)(max_ceiling / 1000), (unsigned long)(max_flag / 1000));
+    } else {
+        printf("✗ FAIL: Blocking not bounded by the ceiling (max %lu µs)\n",
+               (unsigned long)(max_ceiling / 1000));
+    }
+}
+
+TASK(SchedMainTask) {
+    printf("=== AUTOSAR Scheduler Primitive Benchmark ===\n");
+    printf("Iterations: %d\n", TEST_ITERATIONS);
+
+    test_activate();
+    test_event();
+    test_resource();
+
+    TerminateTask();
+}
@@ -0,0 +1,372 @@
+/*
+ * Scheduler Primitive Benchmark for Halo OS (VCOS)
+ * Wakeup latency (semaphore, condvar, event flags), yield context switch,
+ * mutex handoff and priority-inversion blocking with VCOS_MUTEX_PRIO_NONE
+ * vs. VCOS_MUTEX_PRIO_INHERIT (requires CONFIG_PRIORITY_INHERITANCE).
+ * VCOS has no futex; the event-flag test covers the lightest primitive.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+#include <vcos/vcos_thread.h>
+#include <vcos/vcos_sem.h>
+#include <vcos/vcos_event.h>
+#include <vcos/vcos_mutex.h>
+#include "bench_stats.h"
+
+#define TEST_ITERATIONS 100000
+#define PI_ITERATIONS 200
+#define PI_CRITICAL_US 50
+#define PI_HOG_US 2000
+#define MUTEX_THREADS 4
+#define MUTEX_CS_NS 500
+#define MUTEX_IDLE_NS 2000
+#define BENCH_CPU 0
+#define STACK_SIZE 8192
+
+#define PRIO_LOW (VCOS_THREAD_PRI_HIGHEST - 30)
+#define PRIO_MED (VCOS_THREAD_PRI_HIGHEST - 20)
+#define PRIO_HIGH (VCOS_THREAD_PRI_HIGHEST - 10)
+#define PRIO_DRIVER VCOS_THREAD_PRI_HIGHEST
+
+#define EVENT_WAKE 0x1
+
+static uint64_t samples[TEST_ITERATIONS];
+
+static inline uint64_t now_ns(void) {
+    return bench_now_ns(CLOCK_MONOTONIC);
+}
+
+static void spin_ns(uint64_t ns) {
+    uint64_t end = now_ns() + ns;
+    while (now_ns() < end) {
+    }
+}
+
+/* A missing thread would hang its partner or leave zeroed samples: give up */
+static void spawn(vcos_thread_t *t, const char *name, void *(*fn)(void *), void *arg,
+                  int cpu, int prio) {
+    vcos_thread_attr_t attr;
+    vcos_thread_attr_init(&attr);
+    vcos_thread_attr_setpriority(&attr, prio);
+    vcos_thread_attr_setstacksize(&attr, STACK_SIZE);
+    vcos_thread_attr_setcpu(&attr, cpu);
+    if (vcos_thread_create(t, name, &attr, fn, arg) != VCOS_SUCCESS) {
+        fprintf(stderr, "✗ vcos_thread_create(%s) failed\n", name);
+        exit(1);
+    }
+}
+
+static void report(const char *name, const uint64_t *data, size_t count) {
+    bench_stats_t s;
+    bench_hist_t h;
+    bench_stats_compute(data, count, &s);
+    bench_hist_fill(&h, data, count);
+    bench_stats_print(name, &s);
+    bench_hist_print(&h);
+}
+
+/* ---- Wakeup: channel 0 = waker -> waiter, 1 = back ---- */
+
+typedef enum { PRIM_SEM, PRIM_CONDVAR, PRIM_EVENT } prim_t;
+static const char *prim_names[] = { "semaphore", "condvar", "event" };
+
+static prim_t prim;
+static vcos_sem_t sems[2];
+static vcos_event_t events[2];
+static pthread_mutex_t cv_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t cvs[2] = { PTHREAD_COND_INITIALIZER, PTHREAD_COND_INITIALIZER };
+static int cv_flags[2];
+static volatile uint64_t t_signal;
+
+static void prim_signal(int ch) {
+    switch (prim) {
+    case PRIM_SEM:
+        vcos_sem_post(&sems[ch]);
+        break;
+    case PRIM_CONDVAR:
+        pthread_mutex_lock(&cv_lock);
+        cv_flags[ch] = 1;
+        pthread_cond_signal(&cvs[ch]);
+        pthread_mutex_unlock(&cv_lock);
+        break;
+    case PRIM_EVENT:
+        vcos_event_set(&events[ch], EVENT_WAKE);
+        break;
+    }
+}
+
+static void prim_wait(int ch) {
+    uint32_t bits;
+    switch (prim) {
+    case PRIM_SEM:
+        vcos_sem_wait(&sems[ch]);
+        break;
+    case PRIM_CONDVAR:
+        pthread_mutex_lock(&cv_lock);
+        while (!cv_flags[ch]) {
+            pthread_cond_wait(&cvs[ch], &cv_lock);
+        }
+        cv_flags[ch] = 0;
+        pthread_mutex_unlock(&cv_lock);
+        break;
+    case PRIM_EVENT:
+        vcos_event_wait(&events[ch], EVENT_WAKE, VCOS_EVENT_CLEAR, &bits);
+        break;
+    }
+}
+
+static void *wake_waiter(void *arg) {
+    for (int i = 0; i < TEST_ITERATIONS; i++) {
+        prim_wait(0);
+        samples[i] = now_ns() - t_signal;
+        prim_signal(1);
+    }
+    return NULL;
+}
+
+static void *wake_waker(void *arg) {
+    for (int i = 0; i < TEST_ITERATIONS; i++) {
+        t_signal = now_ns();
+        prim_signal(0);
+        prim_wait(1);
+    }
+    return NULL;
+}
+
+static void test_wakeup(void) {
+    printf("\n--- Wakeup latency (CPU %d, waiter above waker) ---\n", BENCH_CPU);
+
+    for (int ch = 0; ch < 2; ch++) {
+        vcos_sem_init(&sems[ch], 0);
+        vcos_event_init(&events[ch]);
+    }
+
+    for (prim = PRIM_SEM; prim <= PRIM_EVENT; prim++) {
+        vcos_thread_t waiter, waker;
+        spawn(&waiter, "waiter", wake_waiter, NULL, BENCH_CPU, PRIO_HIGH);
+        spawn(&waker, "waker", wake_waker, NULL, BENCH_CPU, PRIO_LOW);
+        vcos_thread_join(&waker, NULL);
+        vcos_thread_join(&waiter, NULL);
+
+        char name[64];
+        snprintf(name, sizeof(name), "wakeup/%s", prim_names[prim]);
+        report(name, samples, TEST_ITERATIONS);
+    }
+
+    for (int ch = 0; ch < 2; ch++) {
+        vcos_sem_destroy(&sems[ch]);
+        vcos_event_destroy(&events[ch]);
+    }
+}
+
+/* ---- Context switch: yield ping-pong on one CPU ---- */
+
+static volatile int switch_done;
+
+static void *yield_measure(void *arg) {
+    for (int i = 0; i < TEST_ITERATIONS; i++) {
+        uint64_t t0 = now_ns();
+        vcos_thread_yield();
+        samples[i] = (now_ns() - t0) / 2;
+    }
+    switch_done = 1;
+    return NULL;
+}
+
+static void *yield_partner(void *arg) {
+    while (!switch_done) {
+        vcos_thread_yield();
+    }
+    return NULL;
+}
+
+static void test_switch(void) {
+    printf("\n--- Context switch (yield ping-pong on CPU %d) ---\n", BENCH_CPU);
+    vcos_thread_t a, b;
+    switch_done = 0;
+    spawn(&a, "yield_a", yield_measure, NULL, BENCH_CPU, PRIO_MED);
+    spawn(&b, "yield_b", yield_partner, NULL, BENCH_CPU, PRIO_MED);
+    vcos_thread_join(&a, NULL);
+    vcos_thread_join(&b, NULL);
+    report("switch/yield", samples, TEST_ITERATIONS);
+}
+
+/* ---- Mutex handoff under contention ---- */
+
+static vcos_mutex_t handoff_lock;
+static volatile int handoff_done;
+static int handoffs, last_owner = -1;
+static uint64_t acquisitions, contended, t_unlock;
+
+static void *mutex_worker(void *arg) {
+    int id = (int)(intptr_t)arg;
+    while (!handoff_done) {
+        int blocked = vcos_mutex_trylock(&handoff_lock) != VCOS_SUCCESS;
+        if (blocked) {
+            vcos_mutex_lock(&handoff_lock);
+        }
+        uint64_t now = now_ns();
+
+        acquisitions++;
+        if (blocked) {
+            contended++;
+            if (last_owner != id && handoffs < TEST_ITERATIONS) {
+                samples[handoffs++] = now - t_unlock;
+            }
+        }
+        if (handoffs >= TEST_ITERATIONS || acquisitions >= TEST_ITERATIONS * 20ULL) {
+            handoff_done = 1;
+        }
+
+        spin_ns(MUTEX_CS_NS);
+        last_owner = id;
+        t_unlock = now_ns();
+        vcos_mutex_unlock(&handoff_lock);
+        spin_ns(MUTEX_IDLE_NS);
+    }
+    return NULL;
+}
+
+static void test_mutex(void) {
+    int ncpu = vcos_cpu_count();
+    printf("\n--- Mutex handoff (%d threads over %d CPUs) ---\n", MUTEX_THREADS, ncpu);
+
+    vcos_mutex_init(&handoff_lock, VCOS_MUTEX_PRIO_NONE);
+    vcos_thread_t tids[MUTEX_THREADS];
+    for (int i = 0; i < MUTEX_THREADS; i++) {
+        spawn(&tids[i], "mutex", mutex_worker, (void *)(intptr_t)i, i % ncpu, PRIO_MED);
+    }
+    for (int i = 0; i < MUTEX_THREADS; i++) {
+        vcos_thread_join(&tids[i], NULL);
+    }
+    vcos_mutex_destroy(&handoff_lock);
+
+    report("mutex/handoff", samples, handoffs);
+    printf("  Handoffs:     %d of %d\n", handoffs, TEST_ITERATIONS);
+    printf("  Acquisitions: %lu (%.2f%% contended)\n", (unsigned long)acquisitions,
+           acquisitions ? 100.0 * contended / acquisitions : 0.0);
+    if (handoffs < TEST_ITERATIONS) {
+        printf("⚠ Truncated: acquisition cap reached before %d handoffs%s\n",
+               TEST_ITERATIONS, ncpu < MUTEX_THREADS ? " (fewer CPUs than threads)" : "");
+    }
+}
+
+/* ---- Priority inversion: L holds the mutex, M hogs, H blocks ---- */
+
+static vcos_mutex_t pi_mutex;
+static vcos_sem_t go_low, go_med, go_high, done_med, done_high;
+static volatile int pi_stop;
+
+static void *pi_low(void *arg) {
+    while (1) {
+        vcos_sem_wait(&go_low);
+        if (pi_stop) break;
+        vcos_mutex_lock(&pi_mutex);
+        vcos_sem_post(&go_high);
+        vcos_sem_post(&go_med);
+        spin_ns(PI_CRITICAL_US * 1000ULL);
+        vcos_mutex_unlock(&pi_mutex);
+    }
+    return NULL;
+}
+
+static void *pi_med(void *arg) {
+    while (1) {
+        vcos_sem_wait(&go_med);
+        if (pi_stop) break;
+        spin_ns(PI_HOG_US * 1000ULL);
+        vcos_sem_post(&done_med);
+    }
+    return NULL;
+}
+
+static void *pi_high(void *arg) {
+    for (int i = 0; ; i++) {
+        vcos_sem_wait(&go_high);
+        if (pi_stop) break;
+        uint64_t t_req = now_ns();
+        vcos_mutex_lock(&pi_mutex);
+        samples[i] = now_ns() - t_req;
+        vcos_mutex_unlock(&pi_mutex);
+        vcos_sem_post(&done_high);
+    }
+    return NULL;
+}
+
+static void *pi_driver(void *arg) {
+    for (int i = 0; i < PI_ITERATIONS; i++) {
+        vcos_sem_post(&go_low);
+        vcos_sem_wait(&done_high);
+        vcos_sem_wait(&done_med);
+    }
+    return NULL;
+}
+
+static uint64_t run_pi(int protocol, const char *name) {
+    vcos_thread_t low, med, high, driver;
+
+    pi_stop = 0;
+    vcos_mutex_init(&pi_mutex, protocol);
+    vcos_sem_init(&go_low, 0);
+    vcos_sem_init(&go_med, 0);
+    vcos_sem_init(&go_high, 0);
+    vcos_sem_init(&done_med, 0);
+    vcos_sem_init(&done_high, 0);
+
+    spawn(&low, "pi_low", pi_low, NULL, BENCH_CPU, PRIO_LOW);
+    spawn(&med, "pi_med", pi_med, NULL, BENCH_CPU, PRIO_MED);
+    spawn(&high, "pi_high", pi_high, NULL, BENCH_CPU, PRIO_HIGH);
+    spawn(&driver, "pi_drv", pi_driver, NULL, BENCH_CPU, PRIO_DRIVER);
+    vcos_thread_join(&driver, NULL);
+
+    pi_stop = 1;
+    vcos_sem_post(&go_low);
+    vcos_sem_post(&go_med);
+    vcos_sem_post(&go_high);
+    vcos_thread_join(&low, NULL);
+    vcos_thread_join(&med, NULL);
+    vcos_thread_join(&high, NULL);
+
+    bench_stats_t s;
+    bench_stats_compute(samples, PI_ITERATIONS, &s);
+    report(name, samples, PI_ITERATIONS);
+
+    vcos_mutex_destroy(&pi_mutex);
+    return s.max_ns;
+}
+
+static void test_pi(void) {
+    printf("\n--- Priority inversion (CPU %d, critical section %d µs, hog %d µs) ---\n",
+           BENCH_CPU, PI_CRITICAL_US, PI_HOG_US);
+
+    uint64_t max_none = run_pi(VCOS_MUTEX_PRIO_NONE, "pi/prio_none");
+    uint64_t max_inherit = run_pi(VCOS_MUTEX_PRIO_INHERIT, "pi/prio_inherit");
+
+    printf("\n");
+    if (max_none < PI_HOG_US * 1000ULL) {
+        printf("⚠ INCONCLUSIVE: Baseline never showed the inversion "
+               "(max %.1f µs < hog %d µs)\n", max_none / 1000.0, PI_HOG_US);
+    } else if (max_inherit < (PI_CRITICAL_US + PI_HOG_US / 2) * 1000ULL) {
+        printf("✓ PASS: Inheritance bounds blocking to the critical section "
+               "(max %.1f µs vs %.1f µs without)\n", max_inherit / 1000.0, max_none / 1000.0);
+    } else {
+        printf("✗ FAIL: Blocking not bounded with inheritance (max %.1f µs)\n",
+               max_inherit / 1000.0);
+    }
+}
+
+int main(int argc, char **argv) {
+    printf("=== Halo OS Scheduler Primitive Benchmark ===\n");
+    printf("Iterations: %d\n", TEST_ITERATIONS);
+
+    test_wakeup();
+    test_switch();
+    test_mutex();
+    test_pi();
+
+    return 0;
+}
@@ -0,0 +1,563 @@
+/*
+ * Scheduler Primitive Benchmark for Linux (POSIX backend)
+ * Measures thread-to-thread wakeup latency (semaphore, condvar, eventfd,
+ * futex), context-switch cost, mutex handoff under contention and
+ * priority-inversion blocking with and without PTHREAD_PRIO_INHERIT.
+ * Same tests as schedbench_halo.c / schedbench_qnx.c / schedbench_autosar.c.
+ *
+ * Run as root for SCHED_FIFO; without it the priority-inversion test is
+ * skipped and the others run under SCHED_OTHER.
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <getopt.h>
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include "bench_stats.h"
+#include "bench_rt.h"
+
+#define DEFAULT_ITERATIONS 100000
+#define PI_ITERATIONS 200
+#define PI_CRITICAL_US 50     // low-priority critical section
+#define PI_HOG_US 2000        // medium-priority CPU hog
+#define MUTEX_THREADS 4
+#define MUTEX_CS_NS 500
+#define MUTEX_IDLE_NS 2000
+
+#define PRIO_LOW 10
+#define PRIO_MED 20
+#define PRIO_HIGH 30
+#define PRIO_DRIVER 40
+
+#define TEST_WAKEUP 0x1
+#define TEST_SWITCH 0x2
+#define TEST_MUTEX 0x4
+#define TEST_PI 0x8
+
+static FILE *summary_fp;
+
+static inline uint64_t now_ns(void) {
+    return bench_now_ns(CLOCK_MONOTONIC);
+}
+
+static void spin_ns(uint64_t ns) {
+    uint64_t end = now_ns() + ns;
+    while (now_ns() < end) {
+    }
+}
+
+/* A missing thread would hang its partner or leave zeroed samples: give up */
+static void spawn(pthread_t *t, void *(*fn)(void *), void *arg, int cpu, int prio) {
+    int rc = bench_spawn(t, fn, arg, cpu, prio);
+    if (rc != 0) {
+        fprintf(stderr, "✗ pthread_create: %s (check ulimit -l / RLIMIT_MEMLOCK)\n",
+                strerror(rc));
+        exit(1);
+    }
+}
+
+static void report(const char *name, const uint64_t *samples, size_t count) {
+    bench_stats_t s;
+    bench_hist_t h;
+    bench_stats_compute(samples, count, &s);
+    bench_hist_fill(&h, samples, count);
+    bench_stats_print(name, &s);
+    bench_hist_print(&h);
+
+    if (summary_fp) {
+        fprintf(summary_fp, "posix,%s,%zu,%.3f,%.3f,%.3f,%.3f\n", name, s.count,
+                s.min_ns / 1000.0, s.avg_ns / 1000.0, s.p99_ns / 1000.0, s.max_ns / 1000.0);
+    }
+}
+
+/* ---- Wakeup primitives: channel 0 = waker -> waiter, 1 = back ---- */
+
+typedef struct {
+    const char *name;
+    void (*init)(void);
+    void (*signal)(int ch);
+    void (*wait)(int ch);
+    void (*destroy)(void);
+} wake_prim_t;
+
+static sem_t sems[2];
+static void sem_prim_init(void) { sem_init(&sems[0], 0, 0); sem_init(&sems[1], 0, 0); }
+static void sem_prim_signal(int ch) { sem_post(&sems[ch]); }
+static void sem_prim_wait(int ch) { while (sem_wait(&sems[ch]) < 0 && errno == EINTR) {} }
+static void sem_prim_destroy(void) { sem_destroy(&sems[0]); sem_destroy(&sems[1]); }
+
+static pthread_mutex_t cv_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t cvs[2] = { PTHREAD_COND_INITIALIZER, PTHREAD_COND_INITIALIZER };
+static int cv_flags[2];
+static void cv_prim_init(void) { cv_flags[0] = cv_flags[1] = 0; }
+static void cv_prim_signal(int ch) {
+    pthread_mutex_lock(&cv_lock);
+    cv_flags[ch] = 1;
+    pthread_cond_signal(&cvs[ch]);
+    pthread_mutex_unlock(&cv_lock);
+}
+static void cv_prim_wait(int ch) {
+    pthread_mutex_lock(&cv_lock);
+    while (!cv_flags[ch]) {
+        pthread_cond_wait(&cvs[ch], &cv_lock);
+    }
+    cv_flags[ch] = 0;
+    pthread_mutex_unlock(&cv_lock);
+}
+static void cv_prim_destroy(void) {}
+
+/* eventfd stands in for an RTOS event / pulse */
+static int efds[2];
+static void efd_prim_init(void) { efds[0] = eventfd(0, 0); efds[1] = eventfd(0, 0); }
+static void efd_prim_signal(int ch) {
+    uint64_t one = 1;
+    if (write(efds[ch], &one, sizeof(one)) < 0) perror("eventfd write");
+}
+static void efd_prim_wait(int ch) {
+    uint64_t v;
+    while (read(efds[ch], &v, sizeof(v)) < 0 && errno == EINTR) {}
+}
+static void efd_prim_destroy(void) { close(efds[0]); close(efds[1]); }
+
+static uint32_t futex_words[2];
+static void futex_prim_init(void) { futex_words[0] = futex_words[1] = 0; }
+static void futex_prim_signal(int ch) {
+    __atomic_store_n(&futex_words[ch], 1, __ATOMIC_RELEASE);
+    syscall(SYS_futex, &futex_words[ch], FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+}
+static void futex_prim_wait(int ch) {
+    while (__atomic_exchange_n(&futex_words[ch], 0, __ATOMIC_ACQUIRE) == 0) {
+        syscall(SYS_futex, &futex_words[ch], FUTEX_WAIT_PRIVATE, 0, NULL, NULL, 0);
+    }
+}
+static void futex_prim_destroy(void) {}
+
+static const wake_prim_t wake_prims[] = {
+    { "semaphore", sem_prim_init, sem_prim_signal, sem_prim_wait, sem_prim_destroy },
+    { "condvar", cv_prim_init, cv_prim_signal, cv_prim_wait, cv_prim_destroy },
+    { "eventfd", efd_prim_init, efd_prim_signal, efd_prim_wait, efd_prim_destroy },
+    { "futex", futex_prim_init, futex_prim_signal, futex_prim_wait, futex_prim_destroy },
+};
+
+typedef struct {
+    const wake_prim_t *prim;
+    int iterations;
+    int warmup;
+    uint64_t t_signal;
+    uint64_t *samples;
+} wake_ctx_t;
+
+static void *wake_waiter(void *arg) {
+    wake_ctx_t *ctx = arg;
+    for (int i = 0; i < ctx->warmup + ctx->iterations; i++) {
+        ctx->prim->wait(0);
+        uint64_t now = now_ns();
+        if (i >= ctx->warmup) {
+            ctx->samples[i - ctx->warmup] =
+                now - __atomic_load_n(&ctx->t_signal, __ATOMIC_ACQUIRE);
+        }
+        ctx->prim->signal(1);
+    }
+    return NULL;
+}
+
+static void *wake_waker(void *arg) {
+    wake_ctx_t *ctx = arg;
+    for (int i = 0; i < ctx->warmup + ctx->iterations; i++) {
+        __atomic_store_n(&ctx->t_signal, now_ns(), __ATOMIC_RELEASE);
+        ctx->prim->signal(0);
+        ctx->prim->wait(1);
+    }
+    return NULL;
+}
+
+/*
+ * Waiter runs above the waker, so on a shared CPU the signal preempts
+ * immediately and the sample covers wakeup plus one context switch.
+ */
+static void test_wakeup(int iterations, int waker_cpu, int waiter_cpu) {
+    printf("\n--- Wakeup latency (waker CPU %d -> waiter CPU %d) ---\n",
+           waker_cpu, waiter_cpu);
+    uint64_t *samples = calloc(iterations, sizeof(uint64_t));
+
+    for (size_t p = 0; p < sizeof(wake_prims) / sizeof(wake_prims[0]); p++) {
+        wake_ctx_t ctx = {
+            .prim = &wake_prims[p],
+            .iterations = iterations,
+            .warmup = iterations / 100,
+            .samples = samples,
+        };
+        ctx.prim->init();
+
+        pthread_t waiter, waker;
+        spawn(&waiter, wake_waiter, &ctx, waiter_cpu, PRIO_HIGH);
+        spawn(&waker, wake_waker, &ctx, waker_cpu, PRIO_LOW);
+        pthread_join(waker, NULL);
+        pthread_join(waiter, NULL);
+        ctx.prim->destroy();
+
+        char name[64];
+        snprintf(name, sizeof(name), "wakeup/%s", ctx.prim->name);
+        report(name, samples, iterations);
+    }
+    free(samples);
+}
+
+/* ---- Context switch: two equal-priority threads yielding on one CPU ---- */
+
+typedef struct {
+    int iterations;
+    volatile int done;
+    pthread_barrier_t start;
+    uint64_t *samples;
+} switch_ctx_t;
+
+static void *switch_measure(void *arg) {
+    switch_ctx_t *ctx = arg;
+    pthread_barrier_wait(&ctx->start);
+    for (int i = 0; i < ctx->iterations; i++) {
+        uint64_t t0 = now_ns();
+        sched_yield();
+        /* one round trip = two switches (plus two sched_yield calls) */
+        ctx->samples[i] = (now_ns() - t0) / 2;
+    }
+    ctx->done = 1;
+    return NULL;
+}
+
+static void *switch_partner(void *arg) {
+    switch_ctx_t *ctx = arg;
+    pthread_barrier_wait(&ctx->start);
+    while (!ctx->done) {
+        sched_yield();
+    }
+    return NULL;
+}
+
+static void test_switch(int iterations, int cpu) {
+    printf("\n--- Context switch (sched_yield ping-pong on CPU %d) ---\n", cpu);
+    switch_ctx_t ctx = {
+        .iterations = iterations,
+        .samples = calloc(iterations, sizeof(uint64_t)),
+    };
+    pthread_barrier_init(&ctx.start, NULL, 2);
+
+    pthread_t a, b;
+    spawn(&a, switch_measure, &ctx, cpu, PRIO_MED);
+    spawn(&b, switch_partner, &ctx, cpu, PRIO_MED);
+    pthread_join(a, NULL);
+    pthread_join(b, NULL);
+    pthread_barrier_destroy(&ctx.start);
+
+    report("switch/sched_yield", ctx.samples, iterations);
+    free(ctx.samples);
+}
+
+/* ---- Mutex handoff: unlock by holder -> lock returns in a blocked waiter ---- */
+
+typedef struct {
+    pthread_mutex_t lock;
+    int target;
+    int handoffs;
+    uint64_t acquisitions;
+    uint64_t contended;
+    uint64_t t_unlock;
+    int last_owner;
+    volatile int done;
+    uint64_t *samples;
+} mutex_ctx_t;
+
+typedef struct {
+    mutex_ctx_t *ctx;
+    int id;
+} mutex_arg_t;
+
+static void *mutex_worker(void *arg) {
+    mutex_arg_t *a = arg;
+    mutex_ctx_t *ctx = a->ctx;
+
+    while (!ctx->done) {
+        int blocked = pthread_mutex_trylock(&ctx->lock) != 0;
+        if (blocked) {
+            pthread_mutex_lock(&ctx->lock);
+        }
+        uint64_t now = now_ns();
+
+        ctx->acquisitions++;
+        if (blocked) {
+            ctx->contended++;
+            if (ctx->last_owner != a->id && ctx->handoffs < ctx->target) {
+                ctx->samples[ctx->handoffs++] = now - ctx->t_unlock;
+            }
+        }
+        if (ctx->handoffs >= ctx->target ||
+            ctx->acquisitions >= (uint64_t)ctx->target * 20) {
+            ctx->done = 1;
+        }
+
+        spin_ns(MUTEX_CS_NS);
+        ctx->last_owner = a->id;
+        ctx->t_unlock = now_ns();
+        pthread_mutex_unlock(&ctx->lock);
+        spin_ns(MUTEX_IDLE_NS);
+    }
+    return NULL;
+}
+
+static void test_mutex(int iterations, int threads) {
+    long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+    printf("\n--- Mutex handoff (%d threads over %ld CPUs, SCHED_OTHER) ---\n",
+           threads, ncpu);
+
+    mutex_ctx_t ctx = {
+        .target = iterations,
+        .last_owner = -1,
+        .samples = calloc(iterations, sizeof(uint64_t)),
+    };
+    pthread_mutex_init(&ctx.lock, NULL);
+
+    pthread_t tids[threads];
+    mutex_arg_t args[threads];
+    uint64_t start = now_ns();
+    for (int i = 0; i < threads; i++) {
+        args[i].ctx = &ctx;
+        args[i].id = i;
+        spawn(&tids[i], mutex_worker, &args[i], (int)(i % ncpu), 0);
+    }
+    for (int i = 0; i < threads; i++) {
+        pthread_join(tids[i], NULL);
+    }
+    uint64_t elapsed = now_ns() - start;
+    pthread_mutex_destroy(&ctx.lock);
+
+    report("mutex/handoff", ctx.samples, ctx.handoffs);
+    printf("  Handoffs:     %d of %d\n", ctx.handoffs, iterations);
+    printf("  Acquisitions: %lu (%.2f%% contended, %.0f/s)\n",
+           (unsigned long)ctx.acquisitions,
+           ctx.acquisitions ? 100.0 * ctx.contended / ctx.acquisitions : 0.0,
+           ctx.acquisitions * 1e9 / elapsed);
+    if (ctx.handoffs < iterations) {
+        printf("⚠ Truncated: acquisition cap reached before %d handoffs%s\n", iterations,
+               ncpu < threads ? " (fewer CPUs than threads)" : "");
+    }
+    free(ctx.samples);
+}
+
+/* ---- Priority inversion: L holds the mutex, M hogs, H blocks ---- */
+
+typedef struct {
+    pthread_mutex_t lock;
+    sem_t go_low, go_med, go_high, done_med, done_high;
+    int iterations;
+    volatile int stop;
+    uint64_t *samples;
+} pi_ctx_t;
+
+static void *pi_low(void *arg) {
+    pi_ctx_t *ctx = arg;
+    while (1) {
+        sem_wait(&ctx->go_low);
+        if (ctx->stop) break;
+        pthread_mutex_lock(&ctx->lock);
+        sem_post(&ctx->go_high);  // H preempts and blocks on the mutex
+        sem_post(&ctx->go_med);   // M preempts L unless L inherited H's priority
+        spin_ns(PI_CRITICAL_US * 1000ULL);
+        pthread_mutex_unlock(&ctx->lock);
+    }
+    return NULL;
+}
+
+static void *pi_med(void *arg) {
+    pi_ctx_t *ctx = arg;
+    while (1) {
+        sem_wait(&ctx->go_med);
+        if (ctx->stop) break;
+        spin_ns(PI_HOG_US * 1000ULL);
+        sem_post(&ctx->done_med);
+    }
+    return NULL;
+}
+
+static void *pi_high(void *arg) {
+    pi_ctx_t *ctx = arg;
+    for (int i = 0; ; i++) {
+        sem_wait(&ctx->go_high);
+        if (ctx->stop) break;
+        uint64_t t_req = now_ns();
+        pthread_mutex_lock(&ctx->lock);
+        ctx->samples[i] = now_ns() - t_req;
+        pthread_mutex_unlock(&ctx->lock);
+        sem_post(&ctx->done_high);
+    }
+    return NULL;
+}
+
+static void *pi_driver(void *arg) {
+    pi_ctx_t *ctx = arg;
+    for (int i = 0; i < ctx->iterations; i++) {
+        sem_post(&ctx->go_low);
+        sem_wait(&ctx->done_high);
+        sem_wait(&ctx->done_med);
+    }
+    return NULL;
+}
+
+static uint64_t run_pi(int iterations, int cpu, int protocol, const char *name) {
+    pi_ctx_t ctx = {
+        .iterations = iterations,
+        .samples = calloc(iterations, sizeof(uint64_t)),
+    };
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_setprotocol(&attr, protocol);
+    pthread_mutex_init(&ctx.lock, &attr);
+    pthread_mutexattr_destroy(&attr);
+    sem_init(&ctx.go_low, 0, 0);
+    sem_init(&ctx.go_med, 0, 0);
+    sem_init(&ctx.go_high, 0, 0);
+    sem_init(&ctx.done_med, 0, 0);
+    sem_init(&ctx.done_high, 0, 0);
+
+    pthread_t low, med, high, driver;
+    spawn(&low, pi_low, &ctx, cpu, PRIO_LOW);
+    spawn(&med, pi_med, &ctx, cpu, PRIO_MED);
+    spawn(&high, pi_high, &ctx, cpu, PRIO_HIGH);
+    spawn(&driver, pi_driver, &ctx, cpu, PRIO_DRIVER);
+    pthread_join(driver, NULL);
+
+    ctx.stop = 1;
+    sem_post(&ctx.go_low);
+    sem_post(&ctx.go_med);
+    sem_post(&ctx.go_high);
+    pthread_join(low, NULL);
+    pthread_join(med, NULL);
+    pthread_join(high, NULL);
+
+    bench_stats_t s;
+    bench_stats_compute(ctx.samples, iterations, &s);
+    report(name, ctx.samples, iterations);
+
+    pthread_mutex_destroy(&ctx.lock);
+    sem_destroy(&ctx.go_low);
+    sem_destroy(&ctx.go_med);
+    sem_destroy(&ctx.go_high);
+    sem_destroy(&ctx.done_med);
+    sem_destroy(&ctx.done_high);
+    free(ctx.samples);
+    return s.max_ns;
+}
+
+static void test_pi(int iterations, int cpu) {
+    printf("\n--- Priority inversion (CPU %d, critical section %d µs, hog %d µs) ---\n",
+           cpu, PI_CRITICAL_US, PI_HOG_US);
+    if (!bench_rt_probe()) {
+        printf("⚠ SKIPPED: needs SCHED_FIFO (run as root)\n");
+        return;
+    }
+
+    uint64_t max_none = run_pi(iterations, cpu, PTHREAD_PRIO_NONE, "pi/prio_none");
+    uint64_t max_inherit = run_pi(iterations, cpu, PTHREAD_PRIO_INHERIT, "pi/prio_inherit");
+
+    /* Bounded = H never waits for M, only for L's critical section */
+    uint64_t bound_ns = (PI_CRITICAL_US + PI_HOG_US / 2) * 1000ULL;
+    printf("\n");
+    if (max_none < PI_HOG_US * 1000ULL) {
+        printf("⚠ INCONCLUSIVE: Baseline never showed the inversion "
+               "(max %.1f µs < hog %d µs)\n", max_none / 1000.0, PI_HOG_US);
+    } else if (max_inherit < bound_ns) {
+        printf("✓ PASS: Inheritance bounds blocking to the critical section "
+               "(max %.1f µs vs %.1f µs without)\n", max_inherit / 1000.0, max_none / 1000.0);
+    } else {
+        printf("✗ FAIL: Blocking not bounded with inheritance (max %.1f µs)\n",
+               max_inherit / 1000.0);
+    }
+}
+
+static int parse_tests(const char *arg) {
+    int mask = 0;
+    if (strstr(arg, "wakeup")) mask |= TEST_WAKEUP;
+    if (strstr(arg, "switch")) mask |= TEST_SWITCH;
+    if (strstr(arg, "mutex")) mask |= TEST_MUTEX;
+    if (strstr(arg, "pi")) mask |= TEST_PI;
+    if (strcmp(arg, "all") == 0) mask = TEST_WAKEUP | TEST_SWITCH | TEST_MUTEX | TEST_PI;
+    return mask;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Usage: %s [-t tests] [-n iterations] [-p pi_iterations] [-c cpu]\n"
+            "          [-w waiter_cpu] [-T threads] [-o summary.csv]\n"
+            "  -t  comma list of wakeup,switch,mutex,pi or all (default all)\n"
+            "  -n  iterations per test (default %d)\n"
+            "  -p  priority-inversion iterations (default %d)\n"
+            "  -c  CPU for single-CPU tests and wakeup waker (default 0)\n"
+            "  -w  CPU for the wakeup waiter (default same as -c)\n"
+            "  -T  threads contending in the mutex test (default %d)\n"
+            "  -o  append per-test summary rows to CSV\n",
+            prog, DEFAULT_ITERATIONS, PI_ITERATIONS, MUTEX_THREADS);
+}
+
+int main(int argc, char **argv) {
+    int tests = parse_tests("all");
+    int iterations = DEFAULT_ITERATIONS;
+    int pi_iterations = PI_ITERATIONS;
+    int cpu = 0, waiter_cpu = -1;
+    int threads = MUTEX_THREADS;
+    const char *csv_path = NULL;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "t:n:p:c:w:T:o:h")) != -1) {
+        switch (opt) {
+        case 't': tests = parse_tests(optarg); break;
+        case 'n': iterations = atoi(optarg); break;
+        case 'p': pi_iterations = atoi(optarg); break;
+        case 'c': cpu = atoi(optarg); break;
+        case 'w': waiter_cpu = atoi(optarg); break;
+        case 'T': threads = atoi(optarg); break;
+        case 'o': csv_path = optarg; break;
+        default: usage(argv[0]); return 1;
+        }
+    }
+    if (!tests || iterations <= 0 || pi_iterations <= 0 || threads < 2 || cpu < 0) {
+        usage(argv[0]);
+        return 1;
+    }
+    if (waiter_cpu < 0) {
+        waiter_cpu = cpu;
+    }
+
+    printf("=== Linux POSIX Scheduler Primitive Benchmark ===\n");
+    printf("Iterations: %d\n", iterations);
+
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) < 0) {
+        perror("mlockall (continuing without locked memory)");
+    }
+    if (csv_path) {
+        summary_fp = fopen(csv_path, "a");
+        if (summary_fp && fseek(summary_fp, 0, SEEK_END) == 0 && ftell(summary_fp) == 0) {
+            fprintf(summary_fp, "backend,test,samples,min_us,avg_us,p99_us,max_us\n");
+        }
+    }
+
+    if (tests & TEST_WAKEUP) test_wakeup(iterations, cpu, waiter_cpu);
+    if (tests & TEST_SWITCH) test_switch(iterations, cpu);
+    if (tests & TEST_MUTEX) test_mutex(iterations, threads);
+    if (tests & TEST_PI) test_pi(pi_iterations, cpu);
+
+    if (summary_fp) {
+        fclose(summary_fp);
+        printf("\n✓ Summary appended to %s\n", csv_path);
+    }
+    return 0;
+}
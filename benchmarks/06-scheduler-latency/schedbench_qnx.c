@@ -0,0 +1,465 @@
+/*
+ * Scheduler Primitive Benchmark for QNX 8.0
+ * Wakeup latency (semaphore, condvar, pulse), MsgSend round trip and
+ * sched_yield context switch, mutex handoff, and priority-inversion
+ * blocking: unbounded with a semaphore used as a lock (no owner, no
+ * inheritance) vs. a QNX mutex (priority inheritance by default).
+ * Timestamps from ClockCycles(); threads pinned with _NTO_TCTL_RUNMASK.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <sys/mman.h>
+#include <sys/neutrino.h>
+#include <sys/syspage.h>
+#include "bench_stats.h"
+
+#define TEST_ITERATIONS 100000
+#define PI_ITERATIONS 200
+#define PI_CRITICAL_US 50
+#define PI_HOG_US 2000
+#define MUTEX_THREADS 4
+#define MUTEX_CS_NS 500
+#define MUTEX_IDLE_NS 2000
+#define BENCH_CPU 0
+
+#define PRIO_LOW 10
+#define PRIO_MED 20
+#define PRIO_HIGH 30
+#define PRIO_DRIVER 40
+
+#define PULSE_CODE_WAKE (_PULSE_CODE_MINAVAIL + 1)
+
+static uint64_t cycles_per_sec;
+static uint64_t samples[TEST_ITERATIONS];
+
+static inline uint64_t now_ns(void) {
+    uint64_t c = ClockCycles();
+    return (c / cycles_per_sec) * 1000000000ULL +
+           (c % cycles_per_sec) * 1000000000ULL / cycles_per_sec;
+}
+
+static void spin_ns(uint64_t ns) {
+    uint64_t end = now_ns() + ns;
+    while (now_ns() < end) {
+    }
+}
+
+typedef struct {
+    void *(*fn)(void *);
+    void *arg;
+    int cpu;
+} thread_start_t;
+
+/* Trampoline: apply the run mask from inside the new thread */
+static void *pinned_start(void *arg) {
+    thread_start_t start = *(thread_start_t *)arg;
+    free(arg);
+    if (start.cpu >= 0) {
+        ThreadCtl(_NTO_TCTL_RUNMASK, (void *)(uintptr_t)(1u << start.cpu));
+    }
+    return start.fn(start.arg);
+}
+
+/* A missing thread would hang its partner or leave zeroed samples: give up */
+static void spawn(pthread_t *t, void *(*fn)(void *), void *arg, int cpu, int prio) {
+    pthread_attr_t attr;
+    struct sched_param param = { .sched_priority = prio };
+    thread_start_t *start = malloc(sizeof(*start));
+    start->fn = fn;
+    start->arg = arg;
+    start->cpu = cpu;
+
+    pthread_attr_init(&attr);
+    pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+    pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+    pthread_attr_setschedparam(&attr, &param);
+    int rc = pthread_create(t, &attr, pinned_start, start);
+    pthread_attr_destroy(&attr);
+    if (rc != EOK) {
+        fprintf(stderr, "✗ pthread_create: %s\n", strerror(rc));
+        free(start);
+        exit(1);
+    }
+}
+
+static void report(const char *name, const uint64_t *data, size_t count) {
+    bench_stats_t s;
+    bench_hist_t h;
+    bench_stats_compute(data, count, &s);
+    bench_hist_fill(&h, data, count);
+    bench_stats_print(name, &s);
+    bench_hist_print(&h);
+}
+
+/* ---- Wakeup: channel 0 = waker -> waiter, 1 = back ---- */
+
+typedef enum { PRIM_SEM, PRIM_CONDVAR, PRIM_PULSE } prim_t;
+static const char *prim_names[] = { "semaphore", "condvar", "pulse" };
+
+static prim_t prim;
+static sem_t sems[2];
+static pthread_mutex_t cv_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t cvs[2] = { PTHREAD_COND_INITIALIZER, PTHREAD_COND_INITIALIZER };
+static int cv_flags[2];
+static int chids[2], coids[2];
+static volatile uint64_t t_signal;
+
+static void prim_signal(int ch) {
+    switch (prim) {
+    case PRIM_SEM:
+        sem_post(&sems[ch]);
+        break;
+    case PRIM_CONDVAR:
+        pthread_mutex_lock(&cv_lock);
+        cv_flags[ch] = 1;
+        pthread_cond_signal(&cvs[ch]);
+        pthread_mutex_unlock(&cv_lock);
+        break;
+    case PRIM_PULSE:
+        MsgSendPulse(coids[ch], -1, PULSE_CODE_WAKE, 0);
+        break;
+    }
+}
+
+static void prim_wait(int ch) {
+    struct _pulse pulse;
+    switch (prim) {
+    case PRIM_SEM:
+        sem_wait(&sems[ch]);
+        break;
+    case PRIM_CONDVAR:
+        pthread_mutex_lock(&cv_lock);
+        while (!cv_flags[ch]) {
+            pthread_cond_wait(&cvs[ch], &cv_lock);
+        }
+        cv_flags[ch] = 0;
+        pthread_mutex_unlock(&cv_lock);
+        break;
+    case PRIM_PULSE:
+        MsgReceivePulse(chids[ch], &pulse, sizeof(pulse), NULL);
+        break;
+    }
+}
+
+static void *wake_waiter(void *arg) {
+    for (int i = 0; i < TEST_ITERATIONS; i++) {
+        prim_wait(0);
+        samples[i] = now_ns() - t_signal;
+        prim_signal(1);
+    }
+    return NULL;
+}
+
+static void *wake_waker(void *arg) {
+    for (int i = 0; i < TEST_ITERATIONS; i++) {
+        t_signal = now_ns();
+        prim_signal(0);
+        prim_wait(1);
+    }
+    return NULL;
+}
+
+static void test_wakeup(void) {
+    printf("\n--- Wakeup latency (CPU %d, waiter above waker) ---\n", BENCH_CPU);
+
+    for (int ch = 0; ch < 2; ch++) {
+        sem_init(&sems[ch], 0, 0);
+        chids[ch] = ChannelCreate(_NTO_CHF_PRIVATE);
+        coids[ch] = ConnectAttach(0, 0, chids[ch], _NTO_SIDE_CHANNEL, 0);
+    }
+
+    for (prim = PRIM_SEM; prim <= PRIM_PULSE; prim++) {
+        pthread_t waiter, waker;
+        spawn(&waiter, wake_waiter, NULL, BENCH_CPU, PRIO_HIGH);
+        spawn(&waker, wake_waker, NULL, BENCH_CPU, PRIO_LOW);
+        pthread_join(waker, NULL);
+        pthread_join(waiter, NULL);
+
+        char name[64];
+        snprintf(name, sizeof(name), "wakeup/%s", prim_names[prim]);
+        report(name, samples, TEST_ITERATIONS);
+    }
+
+    for (int ch = 0; ch < 2; ch++) {
+        ConnectDetach(coids[ch]);
+        ChannelDestroy(chids[ch]);
+        sem_destroy(&sems[ch]);
+    }
+}
+
+/* ---- Context switch: MsgSend round trip and sched_yield ping-pong ---- */
+
+static int msg_chid;
+static volatile int switch_done;
+
+static void *msg_server(void *arg) {
+    int msg;
+    while (1) {
+        int rcvid = MsgReceive(msg_chid, &msg, sizeof(msg), NULL);
+        if (rcvid <= 0) {
+            continue;
+        }
+        MsgReply(rcvid, EOK, &msg, sizeof(msg));
+        if (msg < 0) {
+            break;
+        }
+    }
+    return NULL;
+}
+
+static void *msg_client(void *arg) {
+    int coid = ConnectAttach(0, 0, msg_chid, _NTO_SIDE_CHANNEL, 0);
+    int msg, reply;
+    for (int i = 0; i < TEST_ITERATIONS; i++) {
+        msg = i;
+        uint64_t t0 = now_ns();
+        MsgSend(coid, &msg, sizeof(msg), &reply, sizeof(reply));
+        /* send-blocked -> server -> reply: two switches per round trip */
+        samples[i] = (now_ns() - t0) / 2;
+    }
+    msg = -1;
+    MsgSend(coid, &msg, sizeof(msg), &reply, sizeof(reply));
+    ConnectDetach(coid);
+    return NULL;
+}
+
+static void *yield_measure(void *arg) {
+    for (int i = 0; i < TEST_ITERATIONS; i++) {
+        uint64_t t0 = now_ns();
+        sched_yield();
+        samples[i] = (now_ns() - t0) / 2;
+    }
+    switch_done = 1;
+    return NULL;
+}
+
+static void *yield_partner(void *arg) {
+    while (!switch_done) {
+        sched_yield();
+    }
+    return NULL;
+}
+
+static void test_switch(void) {
+    printf("\n--- Context switch (CPU %d) ---\n", BENCH_CPU);
+    pthread_t a, b;
+
+    msg_chid = ChannelCreate(_NTO_CHF_PRIVATE);
+    spawn(&a, msg_server, NULL, BENCH_CPU, PRIO_MED);
+    spawn(&b, msg_client, NULL, BENCH_CPU, PRIO_MED);
+    pthread_join(b, NULL);
+    pthread_join(a, NULL);
+    ChannelDestroy(msg_chid);
+    report("switch/msgsend", samples, TEST_ITERATIONS);
+
+    switch_done = 0;
+    spawn(&a, yield_measure, NULL, BENCH_CPU, PRIO_MED);
+    spawn(&b, yield_partner, NULL, BENCH_CPU, PRIO_MED);
+    pthread_join(a, NULL);
+    pthread_join(b, NULL);
+    report("switch/sched_yield", samples, TEST_ITERATIONS);
+}
+
+/* ---- Mutex handoff under contention (threads spread over CPUs) ---- */
+
+static pthread_mutex_t handoff_lock = PTHREAD_MUTEX_INITIALIZER;
+static volatile int handoff_done;
+static int handoffs, last_owner = -1;
+static uint64_t acquisitions, contended, t_unlock;
+
+static void *mutex_worker(void *arg) {
+    int id = (int)(intptr_t)arg;
+    while (!handoff_done) {
+        int blocked = pthread_mutex_trylock(&handoff_lock) != EOK;
+        if (blocked) {
+            pthread_mutex_lock(&handoff_lock);
+        }
+        uint64_t now = now_ns();
+
+        acquisitions++;
+        if (blocked) {
+            contended++;
+            if (last_owner != id && handoffs < TEST_ITERATIONS) {
+                samples[handoffs++] = now - t_unlock;
+            }
+        }
+        if (handoffs >= TEST_ITERATIONS || acquisitions >= TEST_ITERATIONS * 20ULL) {
+            handoff_done = 1;
+        }
+
+        spin_ns(MUTEX_CS_NS);
+        last_owner = id;
+        t_unlock = now_ns();
+        pthread_mutex_unlock(&handoff_lock);
+        spin_ns(MUTEX_IDLE_NS);
+    }
+    return NULL;
+}
+
+static void test_mutex(void) {
+    int ncpu = _syspage_ptr->num_cpu;
+    printf("\n--- Mutex handoff (%d threads over %d CPUs) ---\n", MUTEX_THREADS, ncpu);
+
+    pthread_t tids[MUTEX_THREADS];
+    for (int i = 0; i < MUTEX_THREADS; i++) {
+        spawn(&tids[i], mutex_worker, (void *)(intptr_t)i, i % ncpu, PRIO_MED);
+    }
+    for (int i = 0; i < MUTEX_THREADS; i++) {
+        pthread_join(tids[i], NULL);
+    }
+
+    report("mutex/handoff", samples, handoffs);
+    printf("  Handoffs:     %d of %d\n", handoffs, TEST_ITERATIONS);
+    printf("  Acquisitions: %lu (%.2f%% contended)\n", (unsigned long)acquisitions,
+           acquisitions ? 100.0 * contended / acquisitions : 0.0);
+    if (handoffs < TEST_ITERATIONS) {
+        printf("⚠ Truncated: acquisition cap reached before %d handoffs%s\n",
+               TEST_ITERATIONS, ncpu < MUTEX_THREADS ? " (fewer CPUs than threads)" : "");
+    }
+}
+
+/* ---- Priority inversion: L holds the lock, M hogs, H blocks ---- */
+
+static int pi_use_mutex;
+static pthread_mutex_t pi_mutex;
+static sem_t pi_sem_lock;
+static sem_t go_low, go_med, go_high, done_med, done_high;
+static volatile int pi_stop;
+
+static void pi_lock(void) {
+    if (pi_use_mutex) pthread_mutex_lock(&pi_mutex);
+    else sem_wait(&pi_sem_lock);
+}
+
+static void pi_unlock(void) {
+    if (pi_use_mutex) pthread_mutex_unlock(&pi_mutex);
+    else sem_post(&pi_sem_lock);
+}
+
+static void *pi_low(void *arg) {
+    while (1) {
+        sem_wait(&go_low);
+        if (pi_stop) break;
+        pi_lock();
+        sem_post(&go_high);
+        sem_post(&go_med);
+        spin_ns(PI_CRITICAL_US * 1000ULL);
+        pi_unlock();
+    }
+    return NULL;
+}
+
+static void *pi_med(void *arg) {
+    while (1) {
+        sem_wait(&go_med);
+        if (pi_stop) break;
+        spin_ns(PI_HOG_US * 1000ULL);
+        sem_post(&done_med);
+    }
+    return NULL;
+}
+
+static void *pi_high(void *arg) {
+    for (int i = 0; ; i++) {
+        sem_wait(&go_high);
+        if (pi_stop) break;
+        uint64_t t_req = now_ns();
+        pi_lock();
+        samples[i] = now_ns() - t_req;
+        pi_unlock();
+        sem_post(&done_high);
+    }
+    return NULL;
+}
+
+static void *pi_driver(void *arg) {
+    for (int i = 0; i < PI_ITERATIONS; i++) {
+        sem_post(&go_low);
+        sem_wait(&done_high);
+        sem_wait(&done_med);
+    }
+    return NULL;
+}
+
+static uint64_t run_pi(int use_mutex, const char *name) {
+    pthread_mutexattr_t attr;
+    pthread_t low, med, high, driver;
+
+    pi_use_mutex = use_mutex;
+    pi_stop = 0;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_setprotocol(&attr, PTHREAD_PRIO_INHERIT);
+    pthread_mutex_init(&pi_mutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+    sem_init(&pi_sem_lock, 0, 1);
+    sem_init(&go_low, 0, 0);
+    sem_init(&go_med, 0, 0);
+    sem_init(&go_high, 0, 0);
+    sem_init(&done_med, 0, 0);
+    sem_init(&done_high, 0, 0);
+
+    spawn(&low, pi_low, NULL, BENCH_CPU, PRIO_LOW);
+    spawn(&med, pi_med, NULL, BENCH_CPU, PRIO_MED);
+    spawn(&high, pi_high, NULL, BENCH_CPU, PRIO_HIGH);
+    spawn(&driver, pi_driver, NULL, BENCH_CPU, PRIO_DRIVER);
+    pthread_join(driver, NULL);
+
+    pi_stop = 1;
+    sem_post(&go_low);
+    sem_post(&go_med);
+    sem_post(&go_high);
+    pthread_join(low, NULL);
+    pthread_join(med, NULL);
+    pthread_join(high, NULL);
+
+    bench_stats_t s;
+    bench_stats_compute(samples, PI_ITERATIONS, &s);
+    report(name, samples, PI_ITERATIONS);
+
+    pthread_mutex_destroy(&pi_mutex);
+    sem_destroy(&pi_sem_lock);
+    return s.max_ns;
+}
+
+static void test_pi(void) {
+    printf("\n--- Priority inversion (CPU %d, critical section %d µs, hog %d µs) ---\n",
+           BENCH_CPU, PI_CRITICAL_US, PI_HOG_US);
+
+    uint64_t max_sem = run_pi(0, "pi/semaphore");
+    uint64_t max_mutex = run_pi(1, "pi/mutex_inherit");
+
+    printf("\n");
+    if (max_sem < PI_HOG_US * 1000ULL) {
+        printf("⚠ INCONCLUSIVE: Baseline never showed the inversion "
+               "(max %.1f µs < hog %d µs)\n", max_sem / 1000.0, PI_HOG_US);
+    } else if (max_mutex < (PI_CRITICAL_US + PI_HOG_US / 2) * 1000ULL) {
+        printf("✓ PASS: Inheritance bounds blocking to the critical section "
+               "(max %.1f µs vs %.1f µs without)\n", max_mutex / 1000.0, max_sem / 1000.0);
+    } else {
+        printf("✗ FAIL: Blocking not bounded with inheritance (max %.1f µs)\n",
+               max_mutex / 1000.0);
+    }
+}
+
+int main(void) {
+    printf("=== QNX Scheduler Primitive Benchmark ===\n");
+    printf("Iterations: %d\n", TEST_ITERATIONS);
+
+    cycles_per_sec = SYSPAGE_ENTRY(qtime)->cycles_per_sec;
+    mlockall(MCL_CURRENT | MCL_FUTURE);
+
+    test_wakeup();
+    test_switch();
+    test_mutex();
+    test_pi();
+
+    return 0;
+}
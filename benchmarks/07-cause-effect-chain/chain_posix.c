@@ -0,0 +1,637 @@
+/*
+ * Cause-Effect Chain Benchmark for Linux (POSIX backend)
+ * Runs an N-stage sensor -> fusion -> planning -> actuator pipeline where
+ * every stage has its own period (0 = event-triggered), priority, CPU and
+ * synthetic compute cost, and forwards a token through the chosen
+ * transport (shared-memory register or SOME/IP over UDP loopback).
+ *
+ * Reported per chain:
+ *   reaction time  stimulus -> first actuator output reflecting it; a
+ *                  stimulus arriving just after sensor read k-1 is first
+ *                  sampled by read k, so it is measured from read k-1
+ *   data age       sensor read -> actuator output, for every output
+ *                  (stale re-reads make it grow past the first use)
+ * plus per-stage contribution on first-use paths and each stage's
+ * fresh / oversampled / undersampled input counts. The default budget is
+ * the analytic worst case from the stage periods, costs and priorities.
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <getopt.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include "bench_stats.h"
+#include "bench_rt.h"
+#include "someip_udp.h"
+
+#define MAX_STAGES 8
+#define DEFAULT_DURATION_S 5
+#define UDP_BASE_PORT 30600
+#define CHAIN_SERVICE_ID 0x1300
+#define RECV_TIMEOUT_MS 100
+#define RELEASE_LEAD_NS 20000000ULL  // all stages started before the first release
+
+#define CHAIN_TOKEN_FIELDS(FIELD, ARRAY, NESTED, NESTED_ARRAY) \
+    FIELD(u32, seq)                                            \
+    FIELD(u32, write_seq)                                      \
+    FIELD(u64, t_sensor_ns)                                    \
+    ARRAY(u64, t_write_ns, MAX_STAGES)
+SERDES_DEFINE(ChainToken_t, CHAIN_TOKEN_FIELDS)
+
+#define TOKEN_MSG_SIZE (SOMEIP_HEADER_SIZE + ChainToken_t_SOMEIP_SIZE)
+
+typedef struct {
+    char name[16];
+    uint64_t period_ns;   // 0 = event-triggered on input arrival
+    uint64_t offset_ns;   // release offset of periodic stages
+    int prio;             // SCHED_FIFO priority, 0 = SCHED_OTHER
+    int cpu;              // -1 = any
+    uint64_t cost_ns;     // synthetic compute, thread CPU time
+
+    /* runtime */
+    int idx;
+    pthread_t tid;
+    int have_input;
+    uint32_t last_write_seq;  // producer's write counter at last read
+    uint32_t writes;
+    uint64_t runs, fresh, oversampled, undersampled, idle;
+} stage_t;
+
+typedef struct {
+    uint32_t seq;
+    uint64_t t_sensor_ns;
+    uint64_t t_write_ns[MAX_STAGES];  // last entry = actuator output
+} output_t;
+
+/* Edge e connects stage e to stage e+1; one producer and one consumer */
+typedef struct {
+    const char *name;
+    int (*init)(int edges);
+    void (*write)(int edge, const ChainToken_t *tok);
+    int (*read)(int edge, ChainToken_t *tok, int block);  // 1 = token valid
+    void (*wake_all)(void);
+    void (*destroy)(void);
+} transport_t;
+
+static stage_t stages[MAX_STAGES];
+static int num_stages;
+static const transport_t *transport;
+static volatile int stop;
+static uint64_t release_epoch_ns;  // common origin of the -s offsets
+
+static uint64_t *sensor_reads;  // t_sensor_ns by seq
+static size_t sensor_cap, sensor_count;
+static output_t *outputs;
+static size_t output_cap, output_count;
+
+static inline uint64_t now_ns(void) {
+    return bench_now_ns(CLOCK_MONOTONIC);
+}
+
+/* Burn CPU time, so preemption by other stages does not shorten the cost */
+static void compute(uint64_t cost_ns) {
+    uint64_t end = bench_now_ns(CLOCK_THREAD_CPUTIME_ID) + cost_ns;
+    while (bench_now_ns(CLOCK_THREAD_CPUTIME_ID) < end) {
+    }
+}
+
+/* ---- Transport: shared-memory register (last-is-best, implicit comm) ---- */
+
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    ChainToken_t tok;
+    uint64_t version;
+    uint64_t seen;  // consumer side, for blocking reads
+} shm_slot_t;
+
+static shm_slot_t shm_slots[MAX_STAGES];
+
+static int shm_init(int edges) {
+    for (int e = 0; e < edges; e++) {
+        pthread_mutex_init(&shm_slots[e].lock, NULL);
+        pthread_cond_init(&shm_slots[e].cond, NULL);
+        shm_slots[e].version = shm_slots[e].seen = 0;
+    }
+    return 0;
+}
+
+static void shm_write(int edge, const ChainToken_t *tok) {
+    shm_slot_t *s = &shm_slots[edge];
+    pthread_mutex_lock(&s->lock);
+    s->tok = *tok;
+    s->version++;
+    pthread_cond_signal(&s->cond);
+    pthread_mutex_unlock(&s->lock);
+}
+
+static int shm_read(int edge, ChainToken_t *tok, int block) {
+    shm_slot_t *s = &shm_slots[edge];
+    pthread_mutex_lock(&s->lock);
+    while (block && s->version == s->seen && !stop) {
+        pthread_cond_wait(&s->cond, &s->lock);
+    }
+    int valid = block ? s->version != s->seen : s->version > 0;
+    if (valid) {
+        *tok = s->tok;
+        s->seen = s->version;
+    }
+    pthread_mutex_unlock(&s->lock);
+    return valid;
+}
+
+static void shm_wake_all(void) {
+    for (int e = 0; e < num_stages - 1; e++) {
+        pthread_mutex_lock(&shm_slots[e].lock);
+        pthread_cond_broadcast(&shm_slots[e].cond);
+        pthread_mutex_unlock(&shm_slots[e].lock);
+    }
+}
+
+static void shm_destroy(void) {
+    for (int e = 0; e < num_stages - 1; e++) {
+        pthread_mutex_destroy(&shm_slots[e].lock);
+        pthread_cond_destroy(&shm_slots[e].cond);
+    }
+}
+
+/* ---- Transport: SOME/IP notifications over UDP loopback ---- */
+
+static int udp_rx[MAX_STAGES], udp_tx[MAX_STAGES];
+static uint16_t udp_session[MAX_STAGES];
+static ChainToken_t udp_cache[MAX_STAGES];  // last token, for periodic re-reads
+static int udp_cached[MAX_STAGES];
+
+static int udp_init(int edges) {
+    for (int e = 0; e < edges; e++) {
+        uint16_t port = UDP_BASE_PORT + e;
+        udp_rx[e] = someip_udp_socket("127.0.0.1", port);
+        udp_tx[e] = someip_udp_socket("127.0.0.1", 0);
+        if (udp_rx[e] < 0 || udp_tx[e] < 0) {
+            return -1;
+        }
+
+        struct timeval tv = { .tv_sec = 0, .tv_usec = RECV_TIMEOUT_MS * 1000 };
+        setsockopt(udp_rx[e], SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+        struct sockaddr_in to = { .sin_family = AF_INET, .sin_port = htons(port) };
+        inet_pton(AF_INET, "127.0.0.1", &to.sin_addr);
+        if (connect(udp_tx[e], (struct sockaddr *)&to, sizeof(to)) < 0) {
+            perror("connect(edge)");
+            return -1;
+        }
+        udp_session[e] = 0;
+        udp_cached[e] = 0;
+    }
+    return 0;
+}
+
+static void udp_write(int edge, const ChainToken_t *tok) {
+    uint8_t buf[TOKEN_MSG_SIZE];
+    if (++udp_session[edge] == 0) {
+        udp_session[edge] = 1;
+    }
+    someip_header_t h = {
+        .service_id = CHAIN_SERVICE_ID,
+        .method_id = 0x8000 | edge,
+        .length = SOMEIP_LENGTH_COVERED + ChainToken_t_SOMEIP_SIZE,
+        .client_id = 0,
+        .session_id = udp_session[edge],
+        .protocol_version = SOMEIP_PROTOCOL_VERSION,
+        .interface_version = 1,
+        .message_type = SOMEIP_MSG_NOTIFICATION,
+        .return_code = SOMEIP_E_OK,
+    };
+    someip_header_put(buf, &h);
+    ChainToken_t_someip_encode(tok, buf + SOMEIP_HEADER_SIZE);
+    send(udp_tx[edge], buf, sizeof(buf), 0);
+}
+
+static int udp_recv_one(int edge, int flags) {
+    uint8_t buf[TOKEN_MSG_SIZE];
+    ssize_t n = recv(udp_rx[edge], buf, sizeof(buf), flags);
+    if (n != TOKEN_MSG_SIZE ||
+        ChainToken_t_someip_decode(buf + SOMEIP_HEADER_SIZE, n - SOMEIP_HEADER_SIZE,
+                                   &udp_cache[edge]) < 0) {
+        return 0;
+    }
+    udp_cached[edge] = 1;
+    return 1;
+}
+
+/* Event-triggered: one datagram per activation. Periodic: drain to newest. */
+static int udp_read(int edge, ChainToken_t *tok, int block) {
+    if (block) {
+        if (!udp_recv_one(edge, 0)) {
+            return 0;
+        }
+    } else {
+        while (udp_recv_one(edge, MSG_DONTWAIT)) {
+        }
+    }
+    if (udp_cached[edge]) {
+        *tok = udp_cache[edge];
+    }
+    return udp_cached[edge];
+}
+
+static void udp_wake_all(void) {
+    /* blocked receivers return within RECV_TIMEOUT_MS */
+}
+
+static void udp_destroy(void) {
+    for (int e = 0; e < num_stages - 1; e++) {
+        close(udp_rx[e]);
+        close(udp_tx[e]);
+    }
+}
+
+static const transport_t transports[] = {
+    { "shm", shm_init, shm_write, shm_read, shm_wake_all, shm_destroy },
+    { "udp", udp_init, udp_write, udp_read, udp_wake_all, udp_destroy },
+};
+
+/* ---- Stages ---- */
+
+/* Same producer write again = oversampled, skipped writes = undersampled */
+static void classify_input(stage_t *st, uint32_t write_seq) {
+    if (!st->have_input) {
+        st->fresh++;
+    } else if (write_seq == st->last_write_seq) {
+        st->oversampled++;
+    } else {
+        st->fresh++;
+        st->undersampled += write_seq - st->last_write_seq - 1;
+    }
+    st->have_input = 1;
+    st->last_write_seq = write_seq;
+}
+
+/* One activation; returns 0 when there was nothing to process */
+static int stage_step(stage_t *st) {
+    ChainToken_t tok;
+    int last = st->idx == num_stages - 1;
+
+    st->runs++;
+    if (st->idx == 0) {
+        if (sensor_count >= sensor_cap) {
+            return 0;
+        }
+        memset(&tok, 0, sizeof(tok));
+        tok.seq = sensor_count;
+        tok.t_sensor_ns = now_ns();
+        sensor_reads[sensor_count++] = tok.t_sensor_ns;
+    } else if (!transport->read(st->idx - 1, &tok, st->period_ns == 0)) {
+        st->idle++;
+        return 0;
+    } else {
+        classify_input(st, tok.write_seq);
+    }
+
+    compute(st->cost_ns);
+    tok.t_write_ns[st->idx] = now_ns();
+
+    if (!last) {
+        tok.write_seq = st->writes++;
+        transport->write(st->idx, &tok);
+    } else if (output_count < output_cap) {
+        output_t *o = &outputs[output_count++];
+        o->seq = tok.seq;
+        o->t_sensor_ns = tok.t_sensor_ns;
+        memcpy(o->t_write_ns, tok.t_write_ns, sizeof(o->t_write_ns));
+    }
+    return 1;
+}
+
+static void *stage_thread(void *arg) {
+    stage_t *st = arg;
+
+    if (st->period_ns == 0) {
+        while (!stop) {
+            stage_step(st);
+        }
+        return NULL;
+    }
+
+    uint64_t next = release_epoch_ns + st->offset_ns;
+    while (!stop) {
+        bench_sleep_until(next);
+        stage_step(st);
+        next += st->period_ns;
+    }
+    return NULL;
+}
+
+/* name:period_us:prio:cpu:cost_us[:offset_us] */
+static int parse_stage(const char *spec, stage_t *st) {
+    unsigned long period_us, cost_us, offset_us = 0;
+    memset(st, 0, sizeof(*st));
+    int n = sscanf(spec, "%15[^:]:%lu:%d:%d:%lu:%lu", st->name, &period_us, &st->prio,
+                   &st->cpu, &cost_us, &offset_us);
+    if (n < 5) {
+        return -1;
+    }
+    st->period_ns = period_us * 1000ULL;
+    st->cost_ns = cost_us * 1000ULL;
+    st->offset_ns = offset_us * 1000ULL;
+    return 0;
+}
+
+/* ---- Analysis ---- */
+
+static void report(const char *name, const uint64_t *data, size_t count, bench_stats_t *s) {
+    bench_hist_t h;
+    bench_stats_compute(data, count, s);
+    bench_hist_fill(&h, data, count);
+    bench_stats_print(name, s);
+    bench_hist_print(&h);
+}
+
+static uint64_t stage_delta(const output_t *o, int i) {
+    uint64_t from = i == 0 ? o->t_sensor_ns : o->t_write_ns[i - 1];
+    return o->t_write_ns[i] - from;
+}
+
+static void print_config(void) {
+    printf("Transport: %s\n", transport->name);
+    printf("\n  %-10s %10s %5s %4s %10s\n", "Stage", "Period", "Prio", "CPU", "Cost");
+    for (int i = 0; i < num_stages; i++) {
+        stage_t *st = &stages[i];
+        char period[24];
+        if (st->period_ns) {
+            snprintf(period, sizeof(period), "%lu µs", (unsigned long)(st->period_ns / 1000));
+        } else {
+            snprintf(period, sizeof(period), "event");
+        }
+        printf("  %-10s %10s %5d %4d %7lu µs\n", st->name, period, st->prio, st->cpu,
+               (unsigned long)(st->cost_ns / 1000));
+    }
+}
+
+/* Event-triggered stages run at the rate of their nearest periodic producer */
+static uint64_t activation_period(int i) {
+    while (stages[i].period_ns == 0) {
+        i--;
+    }
+    return stages[i].period_ns;
+}
+
+/*
+ * Interference-free fixed-priority response time of stage i: its cost plus
+ * every higher-priority stage that can share its CPU (cpu -1 shares all)
+ */
+static uint64_t response_time(int i) {
+    uint64_t r = stages[i].cost_ns, prev = 0;
+    while (r != prev && r < 1000000000ULL) {
+        prev = r;
+        r = stages[i].cost_ns;
+        for (int j = 0; j < num_stages; j++) {
+            int shared = stages[j].cpu < 0 || stages[i].cpu < 0 || stages[j].cpu == stages[i].cpu;
+            if (j != i && shared && stages[j].prio > stages[i].prio) {
+                uint64_t t = activation_period(j);
+                r += (prev + t - 1) / t * stages[j].cost_ns;
+            }
+        }
+    }
+    return r;
+}
+
+/*
+ * Last-is-best worst-case reaction: each periodic stage can just miss its
+ * input and wait a full period, then every stage adds its response time
+ */
+static uint64_t analytic_reaction_ns(void) {
+    uint64_t bound = 0;
+    for (int i = 0; i < num_stages; i++) {
+        bound += stages[i].period_ns + response_time(i);
+    }
+    return bound;
+}
+
+/* Returns 0 on PASS, 1 on FAIL */
+static int analyze(uint64_t budget_us, const char *csv_path) {
+    uint64_t *age = malloc(sizeof(uint64_t) * (output_count + 1));
+    uint64_t *first = malloc(sizeof(uint64_t) * (output_count + 1));
+    uint64_t *reaction = malloc(sizeof(uint64_t) * (sensor_count + 1));
+    uint64_t *contrib[MAX_STAGES];
+    size_t ages = 0, firsts = 0, reactions = 0;
+    int last = num_stages - 1;
+
+    for (int i = 0; i < num_stages; i++) {
+        contrib[i] = malloc(sizeof(uint64_t) * (output_count + 1));
+    }
+
+    /* Outputs are in time order and carry non-decreasing seqs */
+    int have_prev = 0;
+    uint32_t prev_seq = 0;
+    for (size_t k = 0; k < output_count; k++) {
+        const output_t *o = &outputs[k];
+        age[ages++] = o->t_write_ns[last] - o->t_sensor_ns;
+        if (have_prev && o->seq == prev_seq) {
+            continue;
+        }
+        for (int i = 0; i < num_stages; i++) {
+            contrib[i][firsts] = stage_delta(o, i);
+        }
+        first[firsts++] = o->t_write_ns[last] - o->t_sensor_ns;
+        have_prev = 1;
+        prev_seq = o->seq;
+    }
+
+    size_t k = 0;
+    for (size_t s = 1; s < sensor_count; s++) {
+        while (k < output_count && outputs[k].seq < s) {
+            k++;
+        }
+        if (k == output_count) {
+            break;
+        }
+        reaction[reactions++] = outputs[k].t_write_ns[last] - sensor_reads[s - 1];
+    }
+
+    bench_stats_t s_react, s_age, s_first, s_stage;
+    report("Reaction time (stimulus -> first actuator output)", reaction, reactions, &s_react);
+    report("Data age (sensor read -> every actuator output)", age, ages, &s_age);
+    report("Data age, first use", first, firsts, &s_first);
+
+    printf("\nPer-stage contribution (first-use paths):\n");
+    printf("  %-10s %10s %10s %10s %7s\n", "Stage", "Avg µs", "P99 µs", "Max µs", "Share");
+    for (int i = 0; i < num_stages; i++) {
+        bench_stats_compute(contrib[i], firsts, &s_stage);
+        printf("  %-10s %10.2f %10.2f %10.2f %6.1f%%\n", stages[i].name,
+               s_stage.avg_ns / 1000.0, s_stage.p99_ns / 1000.0, s_stage.max_ns / 1000.0,
+               s_first.avg_ns ? 100.0 * s_stage.avg_ns / s_first.avg_ns : 0.0);
+    }
+
+    printf("\nSampling effects (input of each stage):\n");
+    printf("  %-10s %8s %8s %12s %13s %6s\n", "Stage", "Runs", "Fresh", "Oversampled",
+           "Undersampled", "Idle");
+    for (int i = 0; i < num_stages; i++) {
+        stage_t *st = &stages[i];
+        printf("  %-10s %8lu %8lu %12lu %13lu %6lu\n", st->name, (unsigned long)st->runs,
+               (unsigned long)st->fresh, (unsigned long)st->oversampled,
+               (unsigned long)st->undersampled, (unsigned long)st->idle);
+    }
+    printf("  Sensor samples reaching the actuator: %zu / %zu (%.1f%% lost to undersampling)\n",
+           firsts, sensor_count, sensor_count ? 100.0 * (sensor_count - firsts) / sensor_count : 0.0);
+    printf("  Actuator outputs on stale data: %zu / %zu (oversampling)\n", ages - firsts, ages);
+
+    size_t over = 0;
+    for (size_t r = 0; r < reactions; r++) {
+        over += reaction[r] > budget_us * 1000ULL;
+    }
+
+    printf("\nAnalytic worst-case reaction: %.2f ms (sum of periods + response times)\n",
+           analytic_reaction_ns() / 1e6);
+    int pass = reactions > 0 && s_react.max_ns <= budget_us * 1000ULL;
+    if (pass) {
+        printf("✓ PASS: Max reaction time %.2f ms within %.2f ms budget (max data age %.2f ms)\n",
+               s_react.max_ns / 1e6, budget_us / 1000.0, s_age.max_ns / 1e6);
+    } else {
+        printf("✗ FAIL: Max reaction time %.2f ms exceeds %.2f ms budget in %zu of %zu samples "
+               "(max data age %.2f ms)\n",
+               s_react.max_ns / 1e6, budget_us / 1000.0, over, reactions, s_age.max_ns / 1e6);
+    }
+
+    if (csv_path) {
+        bench_stats_save_csv(csv_path, reaction, reactions);
+    }
+
+    for (int i = 0; i < num_stages; i++) {
+        free(contrib[i]);
+    }
+    free(reaction);
+    free(first);
+    free(age);
+    return !pass;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Usage: %s [-s stage]... [-t shm|udp] [-d seconds] [-D budget_us] [-o reaction.csv]\n"
+            "  -s  name:period_us:prio:cpu:cost_us[:offset_us], in chain order\n"
+            "      period 0 = event-triggered, cpu -1 = any, prio 0 = SCHED_OTHER,\n"
+            "      offset relative to a release time shared by all stages\n"
+            "      (default sensor:1000:40:0:100 fusion:2000:30:0:300\n"
+            "               planning:0:20:0:500 actuator:500:50:0:50)\n"
+            "  -t  transport between stages (default shm)\n"
+            "  -d  run time in seconds (default %d)\n"
+            "  -D  reaction-time budget in µs (default: analytic worst case)\n"
+            "  -o  save reaction-time samples to CSV\n",
+            prog, DEFAULT_DURATION_S);
+}
+
+int main(int argc, char **argv) {
+    static const char *default_chain[] = {
+        "sensor:1000:40:0:100",
+        "fusion:2000:30:0:300",
+        "planning:0:20:0:500",
+        "actuator:500:50:0:50",
+    };
+    int duration_s = DEFAULT_DURATION_S;
+    uint64_t budget_us = 0;  // 0 = analytic worst case
+    const char *csv_path = NULL;
+    transport = &transports[0];
+
+    int opt;
+    while ((opt = getopt(argc, argv, "s:t:d:D:o:h")) != -1) {
+        switch (opt) {
+        case 's':
+            if (num_stages == MAX_STAGES || parse_stage(optarg, &stages[num_stages]) < 0) {
+                usage(argv[0]);
+                return 1;
+            }
+            num_stages++;
+            break;
+        case 't':
+            transport = NULL;
+            for (size_t i = 0; i < sizeof(transports) / sizeof(transports[0]); i++) {
+                if (strcmp(optarg, transports[i].name) == 0) {
+                    transport = &transports[i];
+                }
+            }
+            if (!transport) {
+                usage(argv[0]);
+                return 1;
+            }
+            break;
+        case 'd': duration_s = atoi(optarg); break;
+        case 'D': budget_us = strtoull(optarg, NULL, 10); break;
+        case 'o': csv_path = optarg; break;
+        default: usage(argv[0]); return 1;
+        }
+    }
+    if (num_stages == 0) {
+        for (size_t i = 0; i < sizeof(default_chain) / sizeof(default_chain[0]); i++) {
+            parse_stage(default_chain[i], &stages[num_stages++]);
+        }
+    }
+    if (num_stages < 2 || stages[0].period_ns == 0 || duration_s <= 0) {
+        fprintf(stderr, "Need at least two stages and a periodic first stage\n");
+        usage(argv[0]);
+        return 1;
+    }
+
+    printf("=== Linux Cause-Effect Chain Benchmark ===\n");
+    print_config();
+    printf("Duration: %d s\n", duration_s);
+    if (budget_us == 0) {
+        budget_us = (analytic_reaction_ns() + 999) / 1000;
+    }
+    printf("Reaction budget: %lu µs\n", (unsigned long)budget_us);
+
+    /* Worst case: every periodic stage runs every period, event stages once per sample */
+    uint64_t run_ns = duration_s * 1000000000ULL;
+    uint64_t min_period = stages[0].period_ns;
+    for (int i = 0; i < num_stages; i++) {
+        stages[i].idx = i;
+        if (stages[i].period_ns && stages[i].period_ns < min_period) {
+            min_period = stages[i].period_ns;
+        }
+    }
+    sensor_cap = run_ns / stages[0].period_ns + 1;
+    output_cap = run_ns / min_period + sensor_cap + 1;
+    sensor_reads = calloc(sensor_cap, sizeof(*sensor_reads));
+    outputs = calloc(output_cap, sizeof(*outputs));
+    if (!sensor_reads || !outputs) {
+        perror("calloc");
+        return 1;
+    }
+
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) < 0) {
+        perror("mlockall (continuing without locked memory)");
+    }
+    if (transport->init(num_stages - 1) < 0) {
+        return 1;
+    }
+
+    /* Consumers first, so no early token is dropped; periodic stages wait for the epoch */
+    release_epoch_ns = now_ns() + RELEASE_LEAD_NS;
+    for (int i = num_stages - 1; i >= 0; i--) {
+        if (bench_spawn(&stages[i].tid, stage_thread, &stages[i], stages[i].cpu, stages[i].prio) != 0) {
+            fprintf(stderr, "Failed to start stage %s\n", stages[i].name);
+            return 1;
+        }
+    }
+
+    sleep(duration_s);
+    stop = 1;
+    transport->wake_all();
+    for (int i = 0; i < num_stages; i++) {
+        pthread_join(stages[i].tid, NULL);
+    }
+    transport->destroy();
+
+    int rc = analyze(budget_us, csv_path);
+
+    free(outputs);
+    free(sensor_reads);
+    return rc;
+}
@@ -0,0 +1,22 @@
+#!/bin/bash
+# Run the cause-effect chain benchmark over both transports
+
+set -e
+
+echo "=== Cause-Effect Chain Benchmark ==="
+echo ""
+
+make clean
+make all
+
+mkdir -p ../../results/2025-11-benchmarks
+status=0
+for transport in shm udp; do
+    # A budget FAIL exits non-zero; still run the other transport
+    ./chain_posix -t $transport -d 10 \
+        -o ../../results/2025-11-benchmarks/chain_reaction_${transport}.csv || status=1
+done
+
+echo ""
+echo "✓ Tests complete. Results in ../../results/2025-11-benchmarks/"
+exit $status
@@ -0,0 +1,412 @@
+/*
+ * Hardware performance counters per measured region
+ * Wraps a hot path (publish/receive callback, crypto call, VM switch,
+ * timer callback) and reports latency, IPC and per-operation cycles,
+ * instructions, cache misses, branch misses and context switches, so a
+ * cache-bound stack can be told apart from a syscall-bound one.
+ *
+ * The cost of an empty begin/end pair is calibrated at open and subtracted
+ * in the report, so small regions are not dominated by the bracketing.
+ *
+ * Backends:
+ *   Linux         perf_event_open, counting the calling thread in user and
+ *                 kernel mode (user only with BENCH_PERF_USER_ONLY, for
+ *                 regions that make no syscalls); counters the PMU lacks
+ *                 (VMs) read as n/a
+ *   ARMv7/AArch64 PMU registers (cycle counter + 3 event counters) on the
+ *                 bare-metal/RTOS targets; per core, so preemption inside a
+ *                 region is counted and context switches are n/a. EL0 code
+ *                 needs PMUSERENR enabled by the kernel/hypervisor.
+ *   other         latency only
+ *
+ * Usage:
+ *   bench_perf_region_t r;
+ *   bench_perf_open(&r, "publish");      // in the thread (ARM: on the core)
+ *                                        // that runs it; callbacks open on
+ *                                        // their first invocation
+ *   bench_perf_begin(&r); ...; bench_perf_end(&r, msgs);
+ *   bench_perf_report(&r);
+ *   bench_perf_close(&r);
+ */
+
+#ifndef BENCH_PERF_H
+#define BENCH_PERF_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#define BENCH_PERF_LINUX 1
+#elif defined(__aarch64__) || defined(__ARM_ARCH_7A__) || defined(__ARM_ARCH_7R__)
+#define BENCH_PERF_ARM_PMU 1
+#endif
+
+#define BENCH_PERF_USER_ONLY 0x1  // exclude kernel mode (Linux hardware counters)
+#define BENCH_PERF_CALIBRATION_PAIRS 64
+
+typedef enum {
+    BENCH_PERF_CYCLES,
+    BENCH_PERF_INSTRUCTIONS,
+    BENCH_PERF_CACHE_MISSES,
+    BENCH_PERF_BRANCH_MISSES,
+    BENCH_PERF_CONTEXT_SWITCHES,
+    BENCH_PERF_NUM_COUNTERS
+} bench_perf_counter_t;
+
+static const char *const bench_perf_counter_names[BENCH_PERF_NUM_COUNTERS] = {
+    "Cycles", "Instructions", "Cache misses", "Branch misses", "Ctx switches",
+};
+
+typedef struct {
+    const char *name;
+    unsigned available;  // bit per bench_perf_counter_t
+    uint64_t ops;
+    uint64_t pairs;      // begin/end pairs, for the overhead correction
+    uint64_t time_ns;
+    uint64_t t_begin;
+    double overhead_ns;  // per empty begin/end pair
+    double overhead[BENCH_PERF_NUM_COUNTERS];
+#if defined(BENCH_PERF_LINUX)
+    int fd[BENCH_PERF_NUM_COUNTERS];
+    int leader;          // group leader fd, -1 if none
+    unsigned grouped;    // counters enabled through the leader
+#elif defined(BENCH_PERF_ARM_PMU)
+    uint64_t start[BENCH_PERF_NUM_COUNTERS];
+    uint64_t total[BENCH_PERF_NUM_COUNTERS];
+#endif
+} bench_perf_region_t;
+
+static inline uint64_t bench_perf_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+#if defined(BENCH_PERF_LINUX)
+
+static const struct {
+    uint32_t type;
+    uint64_t config;
+} bench_perf_events[BENCH_PERF_NUM_COUNTERS] = {
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+    { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES },
+};
+
+static inline int bench_perf_event_open(int counter, int group_fd, unsigned flags) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = bench_perf_events[counter].type;
+    attr.config = bench_perf_events[counter].config;
+    attr.disabled = group_fd < 0;  // members follow the leader
+    attr.exclude_hv = 1;
+    // context switches happen in the kernel, so they are never excluded
+    attr.exclude_kernel = (flags & BENCH_PERF_USER_ONLY) && attr.type == PERF_TYPE_HARDWARE;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0);
+}
+
+/* Returns the number of counters opened; latency is measured regardless */
+static inline int bench_perf_counters_open(bench_perf_region_t *r, const char *name,
+                                           unsigned flags) {
+    memset(r, 0, sizeof(*r));
+    r->name = name;
+    r->leader = -1;
+
+    for (int c = 0; c < BENCH_PERF_NUM_COUNTERS; c++) {
+        r->fd[c] = -1;
+        if (r->leader >= 0) {
+            r->fd[c] = bench_perf_event_open(c, r->leader, flags);
+            if (r->fd[c] >= 0) {
+                r->grouped |= 1u << c;
+            }
+        }
+        if (r->fd[c] < 0) {
+            r->fd[c] = bench_perf_event_open(c, -1, flags);
+        }
+        if (r->fd[c] < 0) {
+            continue;
+        }
+        if (r->leader < 0) {
+            r->leader = r->fd[c];
+            r->grouped |= 1u << c;
+        }
+        r->available |= 1u << c;
+    }
+
+    if (!r->available) {
+        perror("⚠ perf_event_open (check kernel.perf_event_paranoid), latency only");
+    }
+    return __builtin_popcount(r->available);
+}
+
+static inline void bench_perf_toggle(bench_perf_region_t *r, unsigned long request) {
+    if (r->leader >= 0) {
+        ioctl(r->leader, request, PERF_IOC_FLAG_GROUP);
+    }
+    for (int c = 0; c < BENCH_PERF_NUM_COUNTERS; c++) {
+        if ((r->available & ~r->grouped) & (1u << c)) {
+            ioctl(r->fd[c], request, 0);
+        }
+    }
+}
+
+static inline void bench_perf_begin(bench_perf_region_t *r) {
+    bench_perf_toggle(r, PERF_EVENT_IOC_ENABLE);
+    r->t_begin = bench_perf_now_ns();
+}
+
+static inline void bench_perf_end(bench_perf_region_t *r, uint64_t ops) {
+    uint64_t t_end = bench_perf_now_ns();
+    bench_perf_toggle(r, PERF_EVENT_IOC_DISABLE);
+    r->time_ns += t_end - r->t_begin;
+    r->ops += ops;
+    r->pairs++;
+}
+
+static inline void bench_perf_reset(bench_perf_region_t *r) {
+    if (r->leader >= 0) {
+        ioctl(r->leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    }
+    for (int c = 0; c < BENCH_PERF_NUM_COUNTERS; c++) {
+        if ((r->available & ~r->grouped) & (1u << c)) {
+            ioctl(r->fd[c], PERF_EVENT_IOC_RESET, 0);
+        }
+    }
+    r->ops = r->pairs = r->time_ns = 0;
+}
+
+/* Totals, scaled up when the kernel multiplexed the PMU */
+static inline uint64_t bench_perf_total(const bench_perf_region_t *r, int c) {
+    struct {
+        uint64_t value, enabled, running;
+    } v;
+    if (read(r->fd[c], &v, sizeof(v)) != sizeof(v) || v.running == 0) {
+        return 0;
+    }
+    if (v.running < v.enabled) {
+        return (uint64_t)((double)v.value * v.enabled / v.running);
+    }
+    return v.value;
+}
+
+static inline void bench_perf_close(bench_perf_region_t *r) {
+    for (int c = 0; c < BENCH_PERF_NUM_COUNTERS; c++) {
+        if (r->fd[c] >= 0) {
+            close(r->fd[c]);
+            r->fd[c] = -1;
+        }
+    }
+    r->leader = -1;
+    r->available = 0;
+}
+
+#elif defined(BENCH_PERF_ARM_PMU)
+
+/* ARMv8/ARMv7 common events: INST_RETIRED, L1D_CACHE_REFILL, BR_MIS_PRED */
+static const uint32_t bench_perf_pmu_events[3] = { 0x08, 0x03, 0x10 };
+
+#if defined(__aarch64__)
+#define BENCH_PMU_WRITE(reg, v) __asm__ volatile("msr " #reg ", %0" : : "r"((uint64_t)(v)))
+#define BENCH_PMU_READ(reg, v) __asm__ volatile("mrs %0, " #reg : "=r"(v))
+#define BENCH_PMU_SET_PMCR(v) BENCH_PMU_WRITE(pmcr_el0, v)
+#define BENCH_PMU_SET_CNTEN(v) BENCH_PMU_WRITE(pmcntenset_el0, v)
+#define BENCH_PMU_SELECT(n) BENCH_PMU_WRITE(pmselr_el0, n)
+#define BENCH_PMU_SET_TYPE(v) BENCH_PMU_WRITE(pmxevtyper_el0, v)
+#define BENCH_PMU_GET_EVENT(v) BENCH_PMU_READ(pmxevcntr_el0, v)
+#define BENCH_PMU_GET_CYCLES(v) BENCH_PMU_READ(pmccntr_el0, v)
+#else
+#define BENCH_PMU_CP15_WRITE(crm, op2, v) \
+    __asm__ volatile("mcr p15, 0, %0, c9, " #crm ", " #op2 : : "r"((uint32_t)(v)))
+#define BENCH_PMU_CP15_READ(crm, op2, v) \
+    __asm__ volatile("mrc p15, 0, %0, c9, " #crm ", " #op2 : "=r"(v))
+#define BENCH_PMU_SET_PMCR(v) BENCH_PMU_CP15_WRITE(c12, 0, v)
+#define BENCH_PMU_SET_CNTEN(v) BENCH_PMU_CP15_WRITE(c12, 1, v)
+#define BENCH_PMU_SELECT(n) BENCH_PMU_CP15_WRITE(c12, 5, n)
+#define BENCH_PMU_SET_TYPE(v) BENCH_PMU_CP15_WRITE(c13, 1, v)
+#define BENCH_PMU_GET_EVENT(v) BENCH_PMU_CP15_READ(c13, 2, v)
+#define BENCH_PMU_GET_CYCLES(v) BENCH_PMU_CP15_READ(c13, 0, v)
+#endif
+
+static inline void bench_perf_pmu_snapshot(uint64_t *out) {
+    unsigned long v;
+    BENCH_PMU_GET_CYCLES(v);
+    out[BENCH_PERF_CYCLES] = v;
+    for (int n = 0; n < 3; n++) {
+        BENCH_PMU_SELECT(n);
+        BENCH_PMU_GET_EVENT(v);
+        out[BENCH_PERF_INSTRUCTIONS + n] = (uint32_t)v;
+    }
+}
+
+/* Runs at the caller's exception level: no user/kernel split, flags ignored */
+static inline int bench_perf_counters_open(bench_perf_region_t *r, const char *name,
+                                           unsigned flags) {
+    (void)flags;
+    memset(r, 0, sizeof(*r));
+    r->name = name;
+
+    for (int n = 0; n < 3; n++) {
+        BENCH_PMU_SELECT(n);
+        BENCH_PMU_SET_TYPE(bench_perf_pmu_events[n]);
+    }
+    BENCH_PMU_SET_CNTEN((1u << 31) | 0x7);  // cycle counter + counters 0-2
+    BENCH_PMU_SET_PMCR(0x1);                // enable, keep running totals
+
+    r->available = (1u << BENCH_PERF_CONTEXT_SWITCHES) - 1;
+    return BENCH_PERF_CONTEXT_SWITCHES;
+}
+
+static inline void bench_perf_begin(bench_perf_region_t *r) {
+    bench_perf_pmu_snapshot(r->start);
+    r->t_begin = bench_perf_now_ns();
+}
+
+static inline void bench_perf_end(bench_perf_region_t *r, uint64_t ops) {
+    uint64_t t_end = bench_perf_now_ns();
+    uint64_t now[BENCH_PERF_NUM_COUNTERS];
+    bench_perf_pmu_snapshot(now);
+
+    r->time_ns += t_end - r->t_begin;
+    r->ops += ops;
+    r->pairs++;
+    /* PMCCNTR is 64-bit on AArch64, 32-bit on ARMv7: wrap at native width */
+    r->total[BENCH_PERF_CYCLES] +=
+        (unsigned long)(now[BENCH_PERF_CYCLES] - r->start[BENCH_PERF_CYCLES]);
+    for (int c = BENCH_PERF_INSTRUCTIONS; c <= BENCH_PERF_BRANCH_MISSES; c++) {
+        r->total[c] += (uint32_t)(now[c] - r->start[c]);  // 32-bit event counters
+    }
+}
+
+static inline void bench_perf_reset(bench_perf_region_t *r) {
+    memset(r->total, 0, sizeof(r->total));
+    r->ops = r->pairs = r->time_ns = 0;
+}
+
+static inline uint64_t bench_perf_total(const bench_perf_region_t *r, int c) {
+    return r->total[c];
+}
+
+static inline void bench_perf_close(bench_perf_region_t *r) {
+    r->available = 0;
+}
+
+#else
+
+static inline int bench_perf_counters_open(bench_perf_region_t *r, const char *name,
+                                           unsigned flags) {
+    (void)flags;
+    memset(r, 0, sizeof(*r));
+    r->name = name;
+    return 0;
+}
+
+static inline void bench_perf_begin(bench_perf_region_t *r) {
+    r->t_begin = bench_perf_now_ns();
+}
+
+static inline void bench_perf_end(bench_perf_region_t *r, uint64_t ops) {
+    r->time_ns += bench_perf_now_ns() - r->t_begin;
+    r->ops += ops;
+    r->pairs++;
+}
+
+static inline void bench_perf_reset(bench_perf_region_t *r) {
+    r->ops = r->pairs = r->time_ns = 0;
+}
+
+static inline uint64_t bench_perf_total(const bench_perf_region_t *r, int c) {
+    (void)r;
+    (void)c;
+    return 0;
+}
+
+static inline void bench_perf_close(bench_perf_region_t *r) {
+    (void)r;
+}
+
+#endif
+
+/* Measure an empty begin/end pair (after a warm-up pass) and start from zero */
+static inline void bench_perf_calibrate(bench_perf_region_t *r) {
+    for (int pass = 0; pass < 2; pass++) {
+        bench_perf_reset(r);
+        for (int i = 0; i < BENCH_PERF_CALIBRATION_PAIRS; i++) {
+            bench_perf_begin(r);
+            bench_perf_end(r, 0);
+        }
+    }
+    r->overhead_ns = (double)r->time_ns / BENCH_PERF_CALIBRATION_PAIRS;
+    for (int c = 0; c < BENCH_PERF_NUM_COUNTERS; c++) {
+        if (r->available & (1u << c)) {
+            r->overhead[c] = (double)bench_perf_total(r, c) / BENCH_PERF_CALIBRATION_PAIRS;
+        }
+    }
+    bench_perf_reset(r);
+}
+
+static inline int bench_perf_open_flags(bench_perf_region_t *r, const char *name,
+                                        unsigned flags) {
+    int n = bench_perf_counters_open(r, name, flags);
+    bench_perf_calibrate(r);
+    return n;
+}
+
+static inline int bench_perf_open(bench_perf_region_t *r, const char *name) {
+    return bench_perf_open_flags(r, name, 0);
+}
+
+/* Total minus the calibrated begin/end cost of every pair, floored at 0 */
+static inline double bench_perf_net(double total, double per_pair, uint64_t pairs) {
+    double net = total - per_pair * pairs;
+    return net > 0 ? net : 0;
+}
+
+static inline void bench_perf_report(const bench_perf_region_t *r) {
+    double total[BENCH_PERF_NUM_COUNTERS];
+    double ops = r->ops ? (double)r->ops : 1.0;
+
+    for (int c = 0; c < BENCH_PERF_NUM_COUNTERS; c++) {
+        total[c] = (r->available & (1u << c))
+                       ? bench_perf_net((double)bench_perf_total(r, c), r->overhead[c], r->pairs)
+                       : 0;
+    }
+
+    printf("\nCounters: %s\n", r->name);
+    printf("  Ops:            %lu\n", (unsigned long)r->ops);
+    printf("  Latency:        %.3f µs/op\n",
+           bench_perf_net((double)r->time_ns, r->overhead_ns, r->pairs) / 1000.0 / ops);
+    if (r->available & (1u << BENCH_PERF_CYCLES)) {
+        printf("  Begin/end cost: %.0f ns, %.0f cycles per pair (subtracted)\n",
+               r->overhead_ns, r->overhead[BENCH_PERF_CYCLES]);
+    } else {
+        printf("  Begin/end cost: %.0f ns per pair (subtracted)\n", r->overhead_ns);
+    }
+
+    unsigned ipc_mask = (1u << BENCH_PERF_CYCLES) | (1u << BENCH_PERF_INSTRUCTIONS);
+    if ((r->available & ipc_mask) == ipc_mask && total[BENCH_PERF_CYCLES]) {
+        printf("  IPC:            %.2f\n",
+               total[BENCH_PERF_INSTRUCTIONS] / total[BENCH_PERF_CYCLES]);
+    } else {
+        printf("  IPC:            n/a\n");
+    }
+
+    for (int c = 0; c < BENCH_PERF_NUM_COUNTERS; c++) {
+        if (r->available & (1u << c)) {
+            printf("  %-14s  %.3f /op\n", bench_perf_counter_names[c], total[c] / ops);
+        } else {
+            printf("  %-14s  n/a\n", bench_perf_counter_names[c]);
+        }
+    }
+}
+
+#endif /* BENCH_PERF_H */
@@ -0,0 +1,85 @@
+/*
+ * Thread and timing helpers shared by the Linux-native benchmarks
+ * Pinned SCHED_FIFO thread creation with a SCHED_OTHER fallback when the
+ * caller lacks CAP_SYS_NICE, and absolute-deadline sleeps for periodic loops.
+ * Include after defining _GNU_SOURCE (pthread_attr_setaffinity_np).
+ */
+
+#ifndef BENCH_RT_H
+#define BENCH_RT_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+/* Small explicit stacks keep mlockall(MCL_FUTURE) within RLIMIT_MEMLOCK */
+#define BENCH_RT_STACK_SIZE (256 * 1024)
+
+/* Cleared by the first bench_spawn() that is refused SCHED_FIFO */
+static inline int *bench_rt_state(void) {
+    static int available = 1;
+    return &available;
+}
+
+static inline int bench_rt_available(void) {
+    return *bench_rt_state();
+}
+
+/* Create a thread pinned to cpu (-1 = any) at SCHED_FIFO prio (0 = SCHED_OTHER) */
+static inline int bench_spawn(pthread_t *t, void *(*fn)(void *), void *arg, int cpu,
+                              int prio) {
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, BENCH_RT_STACK_SIZE);
+
+    if (cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        pthread_attr_setaffinity_np(&attr, sizeof(set), &set);
+    }
+    if (prio > 0 && bench_rt_available()) {
+        struct sched_param param = { .sched_priority = prio };
+        pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+        pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+        pthread_attr_setschedparam(&attr, &param);
+    }
+
+    int rc = pthread_create(t, &attr, fn, arg);
+    if (rc == EPERM && prio > 0) {
+        fprintf(stderr, "⚠ SCHED_FIFO not permitted, falling back to SCHED_OTHER\n");
+        *bench_rt_state() = 0;
+        pthread_attr_setinheritsched(&attr, PTHREAD_INHERIT_SCHED);
+        rc = pthread_create(t, &attr, fn, arg);
+    }
+    pthread_attr_destroy(&attr);
+    return rc;
+}
+
+static inline void *bench_rt_noop(void *arg) {
+    return arg;
+}
+
+/* Try a SCHED_FIFO thread once, so bench_rt_available() is known up front */
+static inline int bench_rt_probe(void) {
+    pthread_t t;
+    if (bench_rt_available() && bench_spawn(&t, bench_rt_noop, NULL, -1, 1) == 0) {
+        pthread_join(t, NULL);
+    }
+    return bench_rt_available();
+}
+
+/* Sleep to an absolute CLOCK_MONOTONIC deadline, so periods do not drift */
+static inline void bench_sleep_until(uint64_t deadline_ns) {
+    struct timespec ts = {
+        .tv_sec = deadline_ns / 1000000000ULL,
+        .tv_nsec = deadline_ns % 1000000000ULL,
+    };
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {
+    }
+}
+
+#endif /* BENCH_RT_H */
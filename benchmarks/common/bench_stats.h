@@ -0,0 +1,159 @@
+/*
+ * Shared latency statistics for the Linux-native benchmarks
+ * Same Min/Avg/Max report as halo_vbslite_sub.c, plus P99, log2 latency
+ * histograms and raw CSV dump
+ */
+
+#ifndef BENCH_STATS_H
+#define BENCH_STATS_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct {
+    size_t count;
+    uint64_t min_ns;
+    uint64_t avg_ns;
+    uint64_t p50_ns;
+    uint64_t p99_ns;
+    uint64_t max_ns;
+} bench_stats_t;
+
+static inline uint64_t bench_now_ns(clockid_t clock) {
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static inline uint64_t bench_timespec_ns(const struct timespec *ts) {
+    return (uint64_t)ts->tv_sec * 1000000000ULL + ts->tv_nsec;
+}
+
+static inline int bench_cmp_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+/* Exact percentiles: sorts a copy so the raw samples keep their order for CSV */
+static inline void bench_stats_compute(const uint64_t *samples_ns, size_t count,
+                                       bench_stats_t *out) {
+    memset(out, 0, sizeof(*out));
+    if (count == 0) {
+        return;
+    }
+
+    uint64_t *sorted = malloc(count * sizeof(uint64_t));
+    if (!sorted) {
+        return;
+    }
+    memcpy(sorted, samples_ns, count * sizeof(uint64_t));
+    qsort(sorted, count, sizeof(uint64_t), bench_cmp_u64);
+
+    uint64_t sum = 0;
+    for (size_t i = 0; i < count; i++) {
+        sum += sorted[i];
+    }
+
+    out->count = count;
+    out->min_ns = sorted[0];
+    out->avg_ns = sum / count;
+    out->p50_ns = sorted[count / 2];
+    out->p99_ns = sorted[(count * 99) / 100 < count ? (count * 99) / 100 : count - 1];
+    out->max_ns = sorted[count - 1];
+    free(sorted);
+}
+
+static inline void bench_stats_print(const char *title, const bench_stats_t *s) {
+    printf("\n%s:\n", title);
+    printf("  Samples: %zu\n", s->count);
+    printf("  Min:    %.2f µs\n", s->min_ns / 1000.0);
+    printf("  Avg:    %.2f µs\n", s->avg_ns / 1000.0);
+    printf("  P99:    %.2f µs\n", s->p99_ns / 1000.0);
+    printf("  Max:    %.2f µs\n", s->max_ns / 1000.0);
+}
+
+/* Verdict on the <1ms claim, same wording as halo_vbslite_sub.c */
+static inline int bench_stats_verdict(const bench_stats_t *s, uint64_t threshold_us) {
+    double avg_us = s->avg_ns / 1000.0;
+    if (s->count > 0 && avg_us < threshold_us) {
+        printf("✓ PASS: Validates <%luµs claim (avg = %.2f µs)\n",
+               (unsigned long)threshold_us, avg_us);
+        return 1;
+    }
+    printf("✗ FAIL: Does not meet <%luµs (avg = %.2f µs)\n",
+           (unsigned long)threshold_us, avg_us);
+    return 0;
+}
+
+/* Raw samples in the iteration,latency_us layout read by plot_jitter.py */
+static inline int bench_stats_save_csv(const char *path, const uint64_t *samples_ns,
+                                       size_t count) {
+    FILE *fp = fopen(path, "w");
+    if (!fp) {
+        return -1;
+    }
+    fprintf(fp, "iteration,latency_us\n");
+    for (size_t i = 0; i < count; i++) {
+        fprintf(fp, "%zu,%.3f\n", i, samples_ns[i] / 1000.0);
+    }
+    fclose(fp);
+    printf("✓ Data saved to %s\n", path);
+    return 0;
+}
+
+/* Log2 histogram: bucket i holds samples in [2^i, 2^(i+1)) ns, bucket 0 also 0 */
+#define BENCH_HIST_BUCKETS 32
+
+typedef struct {
+    uint64_t bucket[BENCH_HIST_BUCKETS];
+    uint64_t count;
+} bench_hist_t;
+
+static inline void bench_hist_add(bench_hist_t *h, uint64_t ns) {
+    int i = ns ? 63 - __builtin_clzll(ns) : 0;
+    if (i >= BENCH_HIST_BUCKETS) {
+        i = BENCH_HIST_BUCKETS - 1;
+    }
+    h->bucket[i]++;
+    h->count++;
+}
+
+static inline void bench_hist_fill(bench_hist_t *h, const uint64_t *samples_ns,
+                                   size_t count) {
+    memset(h, 0, sizeof(*h));
+    for (size_t i = 0; i < count; i++) {
+        bench_hist_add(h, samples_ns[i]);
+    }
+}
+
+static inline void bench_hist_print(const bench_hist_t *h) {
+    const int width = 40;
+    uint64_t peak = 0;
+    int first = -1, last = -1;
+
+    for (int i = 0; i < BENCH_HIST_BUCKETS; i++) {
+        if (h->bucket[i]) {
+            if (first < 0) first = i;
+            last = i;
+            if (h->bucket[i] > peak) peak = h->bucket[i];
+        }
+    }
+    if (first < 0) {
+        return;
+    }
+
+    printf("  Histogram (µs):\n");
+    for (int i = first; i <= last; i++) {
+        int bar = (int)(h->bucket[i] * width / peak);
+        if (h->bucket[i] && bar == 0) bar = 1;
+        printf("    [%9.3f, %9.3f) %8lu |%.*s\n",
+               (i ? (1ULL << i) : 0) / 1000.0, (1ULL << (i + 1)) / 1000.0,
+               (unsigned long)h->bucket[i], bar,
+               "########################################");
+    }
+}
+
+#endif /* BENCH_STATS_H */
@@ -0,0 +1,61 @@
+/*
+ * Benchmark payload types, described once for all serializers (serdes.h)
+ * SensorData_t matches the struct in the 02-comms-latency publishers;
+ * ObjectList_t and RadarScan_t add nested structs and large arrays.
+ */
+
+#ifndef SENSOR_TYPES_H
+#define SENSOR_TYPES_H
+
+#include "serdes.h"
+
+#define OBJECT_LIST_MAX 32
+#define RADAR_BINS 256
+
+/* 1kHz IMU sample, 24 bytes on the wire */
+#define SENSOR_DATA_FIELDS(FIELD, ARRAY, NESTED, NESTED_ARRAY) \
+    FIELD(u64, timestamp_us)                                   \
+    FIELD(f32, imu_accel_x)                                    \
+    FIELD(f32, imu_accel_y)                                    \
+    FIELD(f32, imu_accel_z)                                    \
+    FIELD(u32, sequence)
+SERDES_DEFINE(SensorData_t, SENSOR_DATA_FIELDS)
+
+/* Fused track as produced by perception */
+#define TRACKED_OBJECT_FIELDS(FIELD, ARRAY, NESTED, NESTED_ARRAY) \
+    FIELD(u32, id)                                                \
+    FIELD(u8, classification)                                     \
+    FIELD(u8, confidence)                                         \
+    FIELD(u16, age_cycles)                                        \
+    ARRAY(f32, position, 3)                                       \
+    ARRAY(f32, velocity, 3)                                       \
+    ARRAY(f32, covariance, 9)
+SERDES_DEFINE(TrackedObject_t, TRACKED_OBJECT_FIELDS)
+
+/* Object list: nested struct + array of nested structs */
+#define OBJECT_LIST_FIELDS(FIELD, ARRAY, NESTED, NESTED_ARRAY) \
+    FIELD(u64, timestamp_us)                                   \
+    FIELD(u32, sequence)                                       \
+    FIELD(u16, object_count)                                   \
+    NESTED(SensorData_t, ego_motion)                           \
+    NESTED_ARRAY(TrackedObject_t, objects, OBJECT_LIST_MAX)
+SERDES_DEFINE(ObjectList_t, OBJECT_LIST_FIELDS)
+
+/* Radar range/Doppler scan: large primitive arrays */
+#define RADAR_SCAN_FIELDS(FIELD, ARRAY, NESTED, NESTED_ARRAY) \
+    FIELD(u64, timestamp_us)                                  \
+    FIELD(u32, sequence)                                      \
+    ARRAY(f32, range_m, RADAR_BINS)                           \
+    ARRAY(f32, doppler_mps, RADAR_BINS)                       \
+    ARRAY(i16, snr_cdb, RADAR_BINS)
+SERDES_DEFINE(RadarScan_t, RADAR_SCAN_FIELDS)
+
+/* SensorData_t plus the publisher's ns send stamp, for sub-µs transports */
+#define STAMPED_SENSOR_DATA_FIELDS(FIELD, ARRAY, NESTED, NESTED_ARRAY) \
+    FIELD(u64, tx_ns)                                                  \
+    NESTED(SensorData_t, data)
+SERDES_DEFINE(StampedSensorData_t, STAMPED_SENSOR_DATA_FIELDS)
+
+_Static_assert(SensorData_t_SOMEIP_SIZE == 24, "SensorData_t SOME/IP layout changed");
+
+#endif /* SENSOR_TYPES_H */
@@ -0,0 +1,515 @@
+/*
+ * Compile-time generated serializers for benchmark payloads
+ *
+ * A type is described once as an X-macro field list; SERDES_DEFINE() then
+ * expands it into the C struct, the SOME/IP wire size, straight-line
+ * SOME/IP (big-endian, packed) and CDR (XCDR1 little-endian, naturally
+ * aligned) encoders/decoders, and a runtime field descriptor table used by
+ * the reflection-style and PPS text codecs.
+ *
+ *   #define POINT_FIELDS(FIELD, ARRAY, NESTED, NESTED_ARRAY) \
+ *       FIELD(u32, id) \
+ *       ARRAY(f32, xyz, 3)
+ *   SERDES_DEFINE(Point_t, POINT_FIELDS)
+ *
+ * Field types: u8 u16 u32 u64 i16 i32 f32 f64. Arrays are fixed length and
+ * carry no SOME/IP length field. Nested types must be defined first.
+ */
+
+#ifndef SERDES_H
+#define SERDES_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef uint8_t serdes_u8_t;
+typedef uint16_t serdes_u16_t;
+typedef uint32_t serdes_u32_t;
+typedef uint64_t serdes_u64_t;
+typedef int16_t serdes_i16_t;
+typedef int32_t serdes_i32_t;
+typedef float serdes_f32_t;
+typedef double serdes_f64_t;
+
+/* ---- Primitive codecs ---- */
+
+static inline uint8_t serdes_bswap8(uint8_t v) { return v; }
+#define serdes_bswap16 __builtin_bswap16
+#define serdes_bswap32 __builtin_bswap32
+#define serdes_bswap64 __builtin_bswap64
+
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define SERDES_TO_BE(bits, u) serdes_bswap##bits(u)
+#define SERDES_TO_LE(bits, u) (u)
+#else
+#define SERDES_TO_BE(bits, u) (u)
+#define SERDES_TO_LE(bits, u) serdes_bswap##bits(u)
+#endif
+
+/* memcpy keeps unaligned wire access legal; compilers emit a single mov(be) */
+#define SERDES_DEFINE_SCALAR(t, bits)                                            \
+    static inline uint8_t *serdes_put_##t##_be(uint8_t *p, serdes_##t##_t v) {   \
+        uint##bits##_t u;                                                        \
+        memcpy(&u, &v, sizeof(u));                                               \
+        u = SERDES_TO_BE(bits, u);                                               \
+        memcpy(p, &u, sizeof(u));                                                \
+        return p + sizeof(u);                                                    \
+    }                                                                            \
+    static inline uint8_t *serdes_put_##t##_le(uint8_t *p, serdes_##t##_t v) {   \
+        uint##bits##_t u;                                                        \
+        memcpy(&u, &v, sizeof(u));                                               \
+        u = SERDES_TO_LE(bits, u);                                               \
+        memcpy(p, &u, sizeof(u));                                                \
+        return p + sizeof(u);                                                    \
+    }                                                                            \
+    static inline const uint8_t *serdes_get_##t##_be(const uint8_t *p,           \
+                                                     serdes_##t##_t *v) {        \
+        uint##bits##_t u;                                                        \
+        memcpy(&u, p, sizeof(u));                                                \
+        u = SERDES_TO_BE(bits, u);                                               \
+        memcpy(v, &u, sizeof(u));                                                \
+        return p + sizeof(u);                                                    \
+    }                                                                            \
+    static inline const uint8_t *serdes_get_##t##_le(const uint8_t *p,           \
+                                                     serdes_##t##_t *v) {        \
+        uint##bits##_t u;                                                        \
+        memcpy(&u, p, sizeof(u));                                                \
+        u = SERDES_TO_LE(bits, u);                                               \
+        memcpy(v, &u, sizeof(u));                                                \
+        return p + sizeof(u);                                                    \
+    }
+
+SERDES_DEFINE_SCALAR(u8, 8)
+SERDES_DEFINE_SCALAR(u16, 16)
+SERDES_DEFINE_SCALAR(u32, 32)
+SERDES_DEFINE_SCALAR(u64, 64)
+SERDES_DEFINE_SCALAR(i16, 16)
+SERDES_DEFINE_SCALAR(i32, 32)
+SERDES_DEFINE_SCALAR(f32, 32)
+SERDES_DEFINE_SCALAR(f64, 64)
+
+/* CDR aligns each primitive to its size, relative to the stream origin */
+static inline size_t serdes_cdr_align(size_t off, size_t align) {
+    return off + (align - off % align) % align;
+}
+
+static inline uint8_t *serdes_cdr_pad(uint8_t *origin, uint8_t *p, size_t align) {
+    while ((size_t)(p - origin) % align) {
+        *p++ = 0;
+    }
+    return p;
+}
+
+static inline const uint8_t *serdes_cdr_skip(const uint8_t *origin, const uint8_t *p,
+                                             size_t align) {
+    size_t off = (size_t)(p - origin);
+    return p + (align - off % align) % align;
+}
+
+/* ---- SOME/IP header (AUTOSAR PRS_SOMEIP, 16 bytes, big-endian) ---- */
+
+#define SOMEIP_HEADER_SIZE 16
+#define SOMEIP_LENGTH_COVERED 8  // request id .. return code count in length
+#define SOMEIP_PROTOCOL_VERSION 0x01
+#define SOMEIP_MSG_REQUEST 0x00
+#define SOMEIP_MSG_REQUEST_NO_RETURN 0x01
+#define SOMEIP_MSG_NOTIFICATION 0x02
+#define SOMEIP_MSG_RESPONSE 0x80
+#define SOMEIP_MSG_ERROR 0x81
+#define SOMEIP_E_OK 0x00
+
+typedef struct {
+    uint16_t service_id;
+    uint16_t method_id;  // event ids have bit 15 set
+    uint32_t length;
+    uint16_t client_id;
+    uint16_t session_id;
+    uint8_t protocol_version;
+    uint8_t interface_version;
+    uint8_t message_type;
+    uint8_t return_code;
+} someip_header_t;
+
+static inline uint8_t *someip_header_put(uint8_t *p, const someip_header_t *h) {
+    p = serdes_put_u16_be(p, h->service_id);
+    p = serdes_put_u16_be(p, h->method_id);
+    p = serdes_put_u32_be(p, h->length);
+    p = serdes_put_u16_be(p, h->client_id);
+    p = serdes_put_u16_be(p, h->session_id);
+    p = serdes_put_u8_be(p, h->protocol_version);
+    p = serdes_put_u8_be(p, h->interface_version);
+    p = serdes_put_u8_be(p, h->message_type);
+    return serdes_put_u8_be(p, h->return_code);
+}
+
+static inline const uint8_t *someip_header_get(const uint8_t *p, someip_header_t *h) {
+    p = serdes_get_u16_be(p, &h->service_id);
+    p = serdes_get_u16_be(p, &h->method_id);
+    p = serdes_get_u32_be(p, &h->length);
+    p = serdes_get_u16_be(p, &h->client_id);
+    p = serdes_get_u16_be(p, &h->session_id);
+    p = serdes_get_u8_be(p, &h->protocol_version);
+    p = serdes_get_u8_be(p, &h->interface_version);
+    p = serdes_get_u8_be(p, &h->message_type);
+    return serdes_get_u8_be(p, &h->return_code);
+}
+
+/* ---- Runtime descriptors (reflection-style and text codecs) ---- */
+
+typedef enum {
+    SERDES_KIND_u8,
+    SERDES_KIND_u16,
+    SERDES_KIND_u32,
+    SERDES_KIND_u64,
+    SERDES_KIND_i16,
+    SERDES_KIND_i32,
+    SERDES_KIND_f32,
+    SERDES_KIND_f64,
+    SERDES_KIND_STRUCT,
+} serdes_kind_t;
+
+typedef struct serdes_type_desc serdes_type_desc_t;
+
+typedef struct {
+    const char *name;
+    serdes_kind_t kind;
+    size_t offset;
+    size_t count;      // 1 for scalars and single nested structs
+    size_t elem_size;
+    const serdes_type_desc_t *(*nested)(void);
+} serdes_field_desc_t;
+
+struct serdes_type_desc {
+    const char *name;
+    size_t size;
+    size_t field_count;
+    const serdes_field_desc_t *fields;
+};
+
+/* ---- Code generation ---- */
+
+#define SERDES_STRUCT_FIELD(t, n) serdes_##t##_t n;
+#define SERDES_STRUCT_ARRAY(t, n, len) serdes_##t##_t n[len];
+#define SERDES_STRUCT_NESTED(T, n) T n;
+#define SERDES_STRUCT_NESTED_ARRAY(T, n, len) T n[len];
+
+#define SERDES_SIZE_FIELD(t, n) + sizeof(serdes_##t##_t)
+#define SERDES_SIZE_ARRAY(t, n, len) + sizeof(serdes_##t##_t) * (len)
+#define SERDES_SIZE_NESTED(T, n) + T##_SOMEIP_SIZE
+#define SERDES_SIZE_NESTED_ARRAY(T, n, len) + T##_SOMEIP_SIZE * (len)
+
+#define SERDES_SOMEIP_PUT_FIELD(t, n) p = serdes_put_##t##_be(p, v->n);
+#define SERDES_SOMEIP_PUT_ARRAY(t, n, len)                                      \
+    for (size_t i_ = 0; i_ < (len); i_++) p = serdes_put_##t##_be(p, v->n[i_]);
+#define SERDES_SOMEIP_PUT_NESTED(T, n) p = T##_someip_put(p, &v->n);
+#define SERDES_SOMEIP_PUT_NESTED_ARRAY(T, n, len)                               \
+    for (size_t i_ = 0; i_ < (len); i_++) p = T##_someip_put(p, &v->n[i_]);
+
+#define SERDES_SOMEIP_GET_FIELD(t, n) p = serdes_get_##t##_be(p, &v->n);
+#define SERDES_SOMEIP_GET_ARRAY(t, n, len)                                      \
+    for (size_t i_ = 0; i_ < (len); i_++) p = serdes_get_##t##_be(p, &v->n[i_]);
+#define SERDES_SOMEIP_GET_NESTED(T, n) p = T##_someip_get(p, &v->n);
+#define SERDES_SOMEIP_GET_NESTED_ARRAY(T, n, len)                               \
+    for (size_t i_ = 0; i_ < (len); i_++) p = T##_someip_get(p, &v->n[i_]);
+
+#define SERDES_CDR_PUT_FIELD(t, n)                                              \
+    p = serdes_cdr_pad(origin, p, sizeof(serdes_##t##_t));                      \
+    p = serdes_put_##t##_le(p, v->n);
+#define SERDES_CDR_PUT_ARRAY(t, n, len)                                         \
+    p = serdes_cdr_pad(origin, p, sizeof(serdes_##t##_t));                      \
+    for (size_t i_ = 0; i_ < (len); i_++) p = serdes_put_##t##_le(p, v->n[i_]);
+#define SERDES_CDR_PUT_NESTED(T, n) p = T##_cdr_put(origin, p, &v->n);
+#define SERDES_CDR_PUT_NESTED_ARRAY(T, n, len)                                  \
+    for (size_t i_ = 0; i_ < (len); i_++) p = T##_cdr_put(origin, p, &v->n[i_]);
+
+/* Worst case: every primitive run starts one byte past its alignment */
+#define SERDES_CDR_BOUND_FIELD(t, n) + 2 * sizeof(serdes_##t##_t) - 1
+#define SERDES_CDR_BOUND_ARRAY(t, n, len)                                       \
+    + sizeof(serdes_##t##_t) * ((len) + 1) - 1
+#define SERDES_CDR_BOUND_NESTED(T, n) + (T##_CDR_MAX_SIZE - 4)
+#define SERDES_CDR_BOUND_NESTED_ARRAY(T, n, len) + (T##_CDR_MAX_SIZE - 4) * (len)
+
+#define SERDES_CDR_END_FIELD(t, n)                                              \
+    off = serdes_cdr_align(off, sizeof(serdes_##t##_t)) + sizeof(serdes_##t##_t);
+#define SERDES_CDR_END_ARRAY(t, n, len)                                         \
+    off = serdes_cdr_align(off, sizeof(serdes_##t##_t))                         \
+          + sizeof(serdes_##t##_t) * (len);
+#define SERDES_CDR_END_NESTED(T, n) off = T##_cdr_end(off);
+#define SERDES_CDR_END_NESTED_ARRAY(T, n, len)                                  \
+    for (size_t i_ = 0; i_ < (len); i_++) off = T##_cdr_end(off);
+
+#define SERDES_CDR_GET_FIELD(t, n)                                              \
+    p = serdes_cdr_skip(origin, p, sizeof(serdes_##t##_t));                     \
+    p = serdes_get_##t##_le(p, &v->n);
+#define SERDES_CDR_GET_ARRAY(t, n, len)                                         \
+    p = serdes_cdr_skip(origin, p, sizeof(serdes_##t##_t));                     \
+    for (size_t i_ = 0; i_ < (len); i_++) p = serdes_get_##t##_le(p, &v->n[i_]);
+#define SERDES_CDR_GET_NESTED(T, n) p = T##_cdr_get(origin, p, &v->n);
+#define SERDES_CDR_GET_NESTED_ARRAY(T, n, len)                                  \
+    for (size_t i_ = 0; i_ < (len); i_++) p = T##_cdr_get(origin, p, &v->n[i_]);
+
+#define SERDES_DESC_FIELD(t, n)                                                 \
+    { #n, SERDES_KIND_##t, offsetof(serdes_self_t, n), 1,                       \
+      sizeof(serdes_##t##_t), NULL },
+#define SERDES_DESC_ARRAY(t, n, len)                                            \
+    { #n, SERDES_KIND_##t, offsetof(serdes_self_t, n), (len),                   \
+      sizeof(serdes_##t##_t), NULL },
+#define SERDES_DESC_NESTED(T, n)                                                \
+    { #n, SERDES_KIND_STRUCT, offsetof(serdes_self_t, n), 1, sizeof(T),         \
+      T##_desc },
+#define SERDES_DESC_NESTED_ARRAY(T, n, len)                                     \
+    { #n, SERDES_KIND_STRUCT, offsetof(serdes_self_t, n), (len), sizeof(T),     \
+      T##_desc },
+
+#define SERDES_EXPAND(FIELDS, PREFIX)                                           \
+    FIELDS(PREFIX##FIELD, PREFIX##ARRAY, PREFIX##NESTED, PREFIX##NESTED_ARRAY)
+
+/*
+ * Generates for type T:
+ *   T                      the struct
+ *   T##_SOMEIP_SIZE        packed SOME/IP payload size (constant expression)
+ *   T##_CDR_MAX_SIZE       CDR buffer bound incl. 4-byte encapsulation
+ *   T##_cdr_size()         exact CDR size incl. encapsulation
+ *   T##_someip_encode()    -> bytes written (always T##_SOMEIP_SIZE)
+ *   T##_someip_decode()    -> 0, or -1 if the buffer is too short
+ *   T##_cdr_encode()       -> bytes written
+ *   T##_cdr_decode()       -> 0, or -1 on bad encapsulation/short buffer
+ *   T##_desc()             field descriptors for the generic codecs
+ */
+#define SERDES_DEFINE(T, FIELDS)                                                \
+    typedef struct {                                                            \
+        SERDES_EXPAND(FIELDS, SERDES_STRUCT_)                                   \
+    } T;                                                                        \
+                                                                                \
+    enum { T##_SOMEIP_SIZE = 0 SERDES_EXPAND(FIELDS, SERDES_SIZE_) };           \
+    enum { T##_CDR_MAX_SIZE = 4 SERDES_EXPAND(FIELDS, SERDES_CDR_BOUND_) };     \
+                                                                                \
+    static inline uint8_t *T##_someip_put(uint8_t *p, const T *v) {            \
+        SERDES_EXPAND(FIELDS, SERDES_SOMEIP_PUT_)                               \
+        return p;                                                               \
+    }                                                                           \
+    static inline const uint8_t *T##_someip_get(const uint8_t *p, T *v) {      \
+        SERDES_EXPAND(FIELDS, SERDES_SOMEIP_GET_)                               \
+        return p;                                                               \
+    }                                                                           \
+    static inline size_t T##_someip_encode(const T *v, uint8_t *buf) {         \
+        return (size_t)(T##_someip_put(buf, v) - buf);                          \
+    }                                                                           \
+    static inline int T##_someip_decode(const uint8_t *buf, size_t len, T *v) {\
+        if (len < T##_SOMEIP_SIZE) {                                            \
+            return -1;                                                          \
+        }                                                                       \
+        T##_someip_get(buf, v);                                                 \
+        return 0;                                                               \
+    }                                                                           \
+                                                                                \
+    /* End offset of T encoded at stream offset off; sizes are all fixed */    \
+    static inline size_t T##_cdr_end(size_t off) {                              \
+        SERDES_EXPAND(FIELDS, SERDES_CDR_END_)                                  \
+        return off;                                                             \
+    }                                                                           \
+    static inline size_t T##_cdr_size(void) {                                   \
+        return 4 + T##_cdr_end(0);                                              \
+    }                                                                           \
+    static inline uint8_t *T##_cdr_put(uint8_t *origin, uint8_t *p,            \
+                                       const T *v) {                            \
+        SERDES_EXPAND(FIELDS, SERDES_CDR_PUT_)                                  \
+        return p;                                                               \
+    }                                                                           \
+    static inline const uint8_t *T##_cdr_get(const uint8_t *origin,            \
+                                             const uint8_t *p, T *v) {          \
+        SERDES_EXPAND(FIELDS, SERDES_CDR_GET_)                                  \
+        return p;                                                               \
+    }                                                                           \
+    static inline size_t T##_cdr_encode(const T *v, uint8_t *buf) {            \
+        buf[0] = 0x00; /* CDR_LE encapsulation */                               \
+        buf[1] = 0x01;                                                          \
+        buf[2] = 0x00;                                                          \
+        buf[3] = 0x00;                                                          \
+        return (size_t)(T##_cdr_put(buf + 4, buf + 4, v) - buf);                \
+    }                                                                           \
+    static inline int T##_cdr_decode(const uint8_t *buf, size_t len, T *v) {   \
+        if (len < T##_cdr_size() || buf[0] != 0x00 || buf[1] != 0x01) {        \
+            return -1;                                                          \
+        }                                                                       \
+        T##_cdr_get(buf + 4, buf + 4, v);                                       \
+        return 0;                                                               \
+    }                                                                           \
+                                                                                \
+    static inline const serdes_type_desc_t *T##_desc(void) {                   \
+        typedef T serdes_self_t;                                                \
+        static const serdes_field_desc_t fields[] = {                          \
+            SERDES_EXPAND(FIELDS, SERDES_DESC_)                                 \
+        };                                                                      \
+        static const serdes_type_desc_t desc = {                               \
+            #T, sizeof(T), sizeof(fields) / sizeof(fields[0]), fields          \
+        };                                                                      \
+        return &desc;                                                           \
+    }
+
+/* ---- Reflection-style SOME/IP codec: walks descriptors at runtime ---- */
+
+static inline uint8_t *serdes_reflect_someip_put(uint8_t *p,
+                                                 const serdes_type_desc_t *desc,
+                                                 const void *obj) {
+    for (size_t f = 0; f < desc->field_count; f++) {
+        const serdes_field_desc_t *fd = &desc->fields[f];
+        const uint8_t *base = (const uint8_t *)obj + fd->offset;
+
+        for (size_t i = 0; i < fd->count; i++) {
+            const void *elem = base + i * fd->elem_size;
+            switch (fd->kind) {
+            case SERDES_KIND_u8:  p = serdes_put_u8_be(p, *(const uint8_t *)elem); break;
+            case SERDES_KIND_u16: p = serdes_put_u16_be(p, *(const uint16_t *)elem); break;
+            case SERDES_KIND_u32: p = serdes_put_u32_be(p, *(const uint32_t *)elem); break;
+            case SERDES_KIND_u64: p = serdes_put_u64_be(p, *(const uint64_t *)elem); break;
+            case SERDES_KIND_i16: p = serdes_put_i16_be(p, *(const int16_t *)elem); break;
+            case SERDES_KIND_i32: p = serdes_put_i32_be(p, *(const int32_t *)elem); break;
+            case SERDES_KIND_f32: p = serdes_put_f32_be(p, *(const float *)elem); break;
+            case SERDES_KIND_f64: p = serdes_put_f64_be(p, *(const double *)elem); break;
+            case SERDES_KIND_STRUCT:
+                p = serdes_reflect_someip_put(p, fd->nested(), elem);
+                break;
+            }
+        }
+    }
+    return p;
+}
+
+static inline const uint8_t *serdes_reflect_someip_get(const uint8_t *p,
+                                                       const serdes_type_desc_t *desc,
+                                                       void *obj) {
+    for (size_t f = 0; f < desc->field_count; f++) {
+        const serdes_field_desc_t *fd = &desc->fields[f];
+        uint8_t *base = (uint8_t *)obj + fd->offset;
+
+        for (size_t i = 0; i < fd->count; i++) {
+            void *elem = base + i * fd->elem_size;
+            switch (fd->kind) {
+            case SERDES_KIND_u8:  p = serdes_get_u8_be(p, elem); break;
+            case SERDES_KIND_u16: p = serdes_get_u16_be(p, elem); break;
+            case SERDES_KIND_u32: p = serdes_get_u32_be(p, elem); break;
+            case SERDES_KIND_u64: p = serdes_get_u64_be(p, elem); break;
+            case SERDES_KIND_i16: p = serdes_get_i16_be(p, elem); break;
+            case SERDES_KIND_i32: p = serdes_get_i32_be(p, elem); break;
+            case SERDES_KIND_f32: p = serdes_get_f32_be(p, elem); break;
+            case SERDES_KIND_f64: p = serdes_get_f64_be(p, elem); break;
+            case SERDES_KIND_STRUCT:
+                p = serdes_reflect_someip_get(p, fd->nested(), elem);
+                break;
+            }
+        }
+    }
+    return p;
+}
+
+/* ---- PPS text codec ("attr::value" lines, as in qnx_pps_pub.c) ---- */
+
+/*
+ * One line per field, arrays comma separated, nested fields dotted:
+ *   timestamp_us::1234
+ *   objects.position::1.5,2,0
+ * Returns bytes written (excluding NUL) or -1 if buf is too small.
+ */
+static inline int serdes_text_put(char *buf, size_t cap, const char *prefix,
+                                  const serdes_type_desc_t *desc, const void *obj) {
+    size_t len = 0;
+
+    for (size_t f = 0; f < desc->field_count; f++) {
+        const serdes_field_desc_t *fd = &desc->fields[f];
+        const uint8_t *base = (const uint8_t *)obj + fd->offset;
+        char name[128];
+        snprintf(name, sizeof(name), "%s%s%s", prefix, *prefix ? "." : "", fd->name);
+
+        if (fd->kind == SERDES_KIND_STRUCT) {
+            for (size_t i = 0; i < fd->count; i++) {
+                int n = serdes_text_put(buf + len, cap - len, name, fd->nested(),
+                                        base + i * fd->elem_size);
+                if (n < 0) {
+                    return -1;
+                }
+                len += n;
+            }
+            continue;
+        }
+
+        int n = snprintf(buf + len, cap - len, "%s::", name);
+        if (n < 0 || (size_t)n >= cap - len) {
+            return -1;
+        }
+        len += n;
+
+        for (size_t i = 0; i < fd->count; i++) {
+            const void *elem = base + i * fd->elem_size;
+            const char *sep = (i + 1 < fd->count) ? "," : "\n";
+            switch (fd->kind) {
+            case SERDES_KIND_u8:  n = snprintf(buf + len, cap - len, "%u%s", *(const uint8_t *)elem, sep); break;
+            case SERDES_KIND_u16: n = snprintf(buf + len, cap - len, "%u%s", *(const uint16_t *)elem, sep); break;
+            case SERDES_KIND_u32: n = snprintf(buf + len, cap - len, "%u%s", *(const uint32_t *)elem, sep); break;
+            case SERDES_KIND_u64: n = snprintf(buf + len, cap - len, "%llu%s", (unsigned long long)*(const uint64_t *)elem, sep); break;
+            case SERDES_KIND_i16: n = snprintf(buf + len, cap - len, "%d%s", *(const int16_t *)elem, sep); break;
+            case SERDES_KIND_i32: n = snprintf(buf + len, cap - len, "%d%s", *(const int32_t *)elem, sep); break;
+            case SERDES_KIND_f32: n = snprintf(buf + len, cap - len, "%.9g%s", *(const float *)elem, sep); break;
+            case SERDES_KIND_f64: n = snprintf(buf + len, cap - len, "%.17g%s", *(const double *)elem, sep); break;
+            default: n = -1; break;
+            }
+            if (n < 0 || (size_t)n >= cap - len) {
+                return -1;
+            }
+            len += n;
+        }
+    }
+    return (int)len;
+}
+
+/*
+ * Parses text written by serdes_text_put(). Attributes are matched by
+ * position, not name, so this is a lower bound on a real PPS decoder.
+ * Returns the position after the last parsed line, or NULL on error.
+ */
+static inline const char *serdes_text_get(const char *p,
+                                          const serdes_type_desc_t *desc, void *obj) {
+    for (size_t f = 0; f < desc->field_count && p; f++) {
+        const serdes_field_desc_t *fd = &desc->fields[f];
+        uint8_t *base = (uint8_t *)obj + fd->offset;
+
+        if (fd->kind == SERDES_KIND_STRUCT) {
+            for (size_t i = 0; i < fd->count && p; i++) {
+                p = serdes_text_get(p, fd->nested(), base + i * fd->elem_size);
+            }
+            continue;
+        }
+
+        p = strstr(p, "::");
+        if (!p) {
+            return NULL;
+        }
+        p += 2;
+
+        for (size_t i = 0; i < fd->count; i++) {
+            void *elem = base + i * fd->elem_size;
+            char *end;
+            switch (fd->kind) {
+            case SERDES_KIND_u8:  *(uint8_t *)elem = (uint8_t)strtoul(p, &end, 10); break;
+            case SERDES_KIND_u16: *(uint16_t *)elem = (uint16_t)strtoul(p, &end, 10); break;
+            case SERDES_KIND_u32: *(uint32_t *)elem = (uint32_t)strtoul(p, &end, 10); break;
+            case SERDES_KIND_u64: *(uint64_t *)elem = strtoull(p, &end, 10); break;
+            case SERDES_KIND_i16: *(int16_t *)elem = (int16_t)strtol(p, &end, 10); break;
+            case SERDES_KIND_i32: *(int32_t *)elem = (int32_t)strtol(p, &end, 10); break;
+            case SERDES_KIND_f32: *(float *)elem = strtof(p, &end); break;
+            case SERDES_KIND_f64: *(double *)elem = strtod(p, &end); break;
+            default: return NULL;
+            }
+            if (end == p || (*end != ',' && *end != '\n')) {
+                return NULL;
+            }
+            p = end + 1;
+        }
+    }
+    return p;
+}
+
+#endif /* SERDES_H */
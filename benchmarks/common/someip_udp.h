@@ -0,0 +1,253 @@
+/*
+ * SOME/IP over UDP helpers for the Linux-native transport benchmark
+ * Minimal SOME/IP-SD stand-in (one entry + one IPv4 endpoint option per
+ * message, unicast only) and socket setup for kernel timestamping.
+ *
+ * Handshake replacing SomeIpSd_OfferService / Rte_..._Subscribe:
+ *   publisher  -> OfferService            -> subscriber SD port
+ *   subscriber -> SubscribeEventgroup     -> publisher SD port
+ *   publisher  -> SubscribeEventgroupAck  -> subscriber SD port
+ * The wire format follows PRS_SOMEIPServiceDiscovery, so captures decode
+ * in Wireshark, but there is no multicast, repetition phase or TTL expiry.
+ */
+
+#ifndef SOMEIP_UDP_H
+#define SOMEIP_UDP_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <net/if.h>
+#include <netinet/in.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <linux/net_tstamp.h>
+#include <linux/sockios.h>
+#include <linux/errqueue.h>
+#include "serdes.h"
+
+#define SOMEIP_SD_PORT 30490
+#define SOMEIP_SD_CLIENT_PORT 30491  // stand-in: subscriber SD port (unicast)
+#define SOMEIP_SD_SERVICE_ID 0xFFFF
+#define SOMEIP_SD_METHOD_ID 0x8100
+#define SOMEIP_SD_FLAGS 0xC0  // reboot + unicast
+#define SOMEIP_SD_TTL_S 3
+
+#define SOMEIP_SD_OFFER_SERVICE 0x01
+#define SOMEIP_SD_SUBSCRIBE_EVENTGROUP 0x06
+#define SOMEIP_SD_SUBSCRIBE_ACK 0x07
+
+#define SOMEIP_SD_OPTION_IPV4_ENDPOINT 0x04
+#define SOMEIP_SD_L4_UDP 0x11
+
+#define SOMEIP_SD_ENTRY_SIZE 16
+#define SOMEIP_SD_OPTION_SIZE 12
+#define SOMEIP_SD_MSG_SIZE (SOMEIP_HEADER_SIZE + 4 + 4 + SOMEIP_SD_ENTRY_SIZE + \
+                            4 + SOMEIP_SD_OPTION_SIZE)
+
+typedef struct {
+    uint8_t type;
+    uint16_t service_id;
+    uint16_t instance_id;
+    uint8_t major_version;
+    uint32_t ttl;            // 24 bits on the wire; 0 = stop
+    uint32_t minor_version;  // service entries only
+    uint16_t eventgroup_id;  // eventgroup entries only
+    uint32_t ipv4;           // endpoint option, host byte order
+    uint16_t port;
+} someip_sd_entry_t;
+
+static inline size_t someip_sd_build(uint8_t *buf, uint16_t session,
+                                     const someip_sd_entry_t *e) {
+    someip_header_t h = {
+        .service_id = SOMEIP_SD_SERVICE_ID,
+        .method_id = SOMEIP_SD_METHOD_ID,
+        .length = SOMEIP_SD_MSG_SIZE - SOMEIP_HEADER_SIZE + SOMEIP_LENGTH_COVERED,
+        .client_id = 0,
+        .session_id = session,
+        .protocol_version = SOMEIP_PROTOCOL_VERSION,
+        .interface_version = 1,
+        .message_type = SOMEIP_MSG_NOTIFICATION,
+        .return_code = SOMEIP_E_OK,
+    };
+    uint8_t *p = someip_header_put(buf, &h);
+
+    p = serdes_put_u8_be(p, SOMEIP_SD_FLAGS);
+    p = serdes_put_u8_be(p, 0);
+    p = serdes_put_u16_be(p, 0);
+    p = serdes_put_u32_be(p, SOMEIP_SD_ENTRY_SIZE);
+
+    p = serdes_put_u8_be(p, e->type);
+    p = serdes_put_u8_be(p, 0);     // index of first option run
+    p = serdes_put_u8_be(p, 0);     // index of second option run
+    p = serdes_put_u8_be(p, 0x10);  // one option in the first run
+    p = serdes_put_u16_be(p, e->service_id);
+    p = serdes_put_u16_be(p, e->instance_id);
+    p = serdes_put_u32_be(p, ((uint32_t)e->major_version << 24) | (e->ttl & 0xFFFFFF));
+    if (e->type == SOMEIP_SD_OFFER_SERVICE) {
+        p = serdes_put_u32_be(p, e->minor_version);
+    } else {
+        p = serdes_put_u8_be(p, 0);
+        p = serdes_put_u8_be(p, 0);  // no initial data requested, counter 0
+        p = serdes_put_u16_be(p, e->eventgroup_id);
+    }
+
+    p = serdes_put_u32_be(p, SOMEIP_SD_OPTION_SIZE);
+    p = serdes_put_u16_be(p, SOMEIP_SD_OPTION_SIZE - 3);
+    p = serdes_put_u8_be(p, SOMEIP_SD_OPTION_IPV4_ENDPOINT);
+    p = serdes_put_u8_be(p, 0);
+    p = serdes_put_u32_be(p, e->ipv4);
+    p = serdes_put_u8_be(p, 0);
+    p = serdes_put_u8_be(p, SOMEIP_SD_L4_UDP);
+    p = serdes_put_u16_be(p, e->port);
+
+    return (size_t)(p - buf);
+}
+
+/* Returns 0 for a well-formed single-entry SD message, -1 otherwise */
+static inline int someip_sd_parse(const uint8_t *buf, size_t len, someip_sd_entry_t *e) {
+    if (len < SOMEIP_SD_MSG_SIZE) {
+        return -1;
+    }
+
+    someip_header_t h;
+    const uint8_t *p = someip_header_get(buf, &h);
+    if (h.service_id != SOMEIP_SD_SERVICE_ID || h.method_id != SOMEIP_SD_METHOD_ID) {
+        return -1;
+    }
+
+    uint32_t entries_len, word, options_len;
+    uint8_t option_type;
+    p += 4;  // flags + reserved
+    p = serdes_get_u32_be(p, &entries_len);
+    if (entries_len < SOMEIP_SD_ENTRY_SIZE) {
+        return -1;
+    }
+
+    memset(e, 0, sizeof(*e));
+    p = serdes_get_u8_be(p, &e->type);
+    p += 3;  // option indices and counts
+    p = serdes_get_u16_be(p, &e->service_id);
+    p = serdes_get_u16_be(p, &e->instance_id);
+    p = serdes_get_u32_be(p, &word);
+    e->major_version = word >> 24;
+    e->ttl = word & 0xFFFFFF;
+    if (e->type == SOMEIP_SD_OFFER_SERVICE) {
+        p = serdes_get_u32_be(p, &e->minor_version);
+    } else {
+        p += 2;
+        p = serdes_get_u16_be(p, &e->eventgroup_id);
+    }
+    if (entries_len - SOMEIP_SD_ENTRY_SIZE > (size_t)(buf + len - p)) {
+        return -1;
+    }
+    p += entries_len - SOMEIP_SD_ENTRY_SIZE;
+
+    if ((size_t)(p - buf) + 4 + SOMEIP_SD_OPTION_SIZE > len) {
+        return -1;
+    }
+    p = serdes_get_u32_be(p, &options_len);
+    p += 2;  // option length
+    p = serdes_get_u8_be(p, &option_type);
+    if (options_len < SOMEIP_SD_OPTION_SIZE || option_type != SOMEIP_SD_OPTION_IPV4_ENDPOINT) {
+        return -1;
+    }
+    p += 1;  // reserved
+    p = serdes_get_u32_be(p, &e->ipv4);
+    p += 2;  // reserved + L4 protocol
+    serdes_get_u16_be(p, &e->port);
+    return 0;
+}
+
+static inline int someip_udp_socket(const char *bind_ip, uint16_t port) {
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) {
+        perror("socket(udp)");
+        return -1;
+    }
+
+    int enable = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    if (inet_pton(AF_INET, bind_ip, &addr.sin_addr) != 1) {
+        fprintf(stderr, "Invalid address: %s\n", bind_ip);
+        close(fd);
+        return -1;
+    }
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        perror("bind(udp)");
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/*
+ * Requests software RX stamps and, when hw_ifname is given, programs the
+ * NIC for hardware RX stamping of all packets (needs a PTP-capable NIC;
+ * loopback and veth only provide software stamps).
+ */
+static inline int someip_udp_enable_timestamps(int fd, const char *hw_ifname) {
+    int flags = SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+
+    if (hw_ifname) {
+        struct hwtstamp_config cfg = {
+            .flags = 0,
+            .tx_type = HWTSTAMP_TX_OFF,
+            .rx_filter = HWTSTAMP_FILTER_ALL,
+        };
+        struct ifreq ifr;
+        memset(&ifr, 0, sizeof(ifr));
+        strncpy(ifr.ifr_name, hw_ifname, IFNAMSIZ - 1);
+        ifr.ifr_data = (void *)&cfg;
+        if (ioctl(fd, SIOCSHWTSTAMP, &ifr) < 0) {
+            perror("SIOCSHWTSTAMP (falling back to software stamps)");
+        } else {
+            flags |= SOF_TIMESTAMPING_RX_HARDWARE | SOF_TIMESTAMPING_RAW_HARDWARE;
+        }
+    }
+
+    if (setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags)) < 0) {
+        perror("SO_TIMESTAMPING");
+        return -1;
+    }
+    return 0;
+}
+
+/* Local address the kernel routes from when talking to peer (host order) */
+static inline uint32_t someip_udp_local_ip_for(uint32_t peer_ipv4, uint16_t peer_port) {
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    struct sockaddr_in addr = {
+        .sin_family = AF_INET,
+        .sin_port = htons(peer_port),
+        .sin_addr.s_addr = htonl(peer_ipv4),
+    };
+    socklen_t len = sizeof(addr);
+    uint32_t local = INADDR_LOOPBACK;
+
+    if (fd >= 0 && connect(fd, (struct sockaddr *)&addr, sizeof(addr)) == 0 &&
+        getsockname(fd, (struct sockaddr *)&addr, &len) == 0) {
+        local = ntohl(addr.sin_addr.s_addr);
+    }
+    if (fd >= 0) {
+        close(fd);
+    }
+    return local;
+}
+
+static inline const struct scm_timestamping *someip_udp_rx_stamps(struct msghdr *msg) {
+    for (struct cmsghdr *cm = CMSG_FIRSTHDR(msg); cm; cm = CMSG_NXTHDR(msg, cm)) {
+        if (cm->cmsg_level == SOL_SOCKET && cm->cmsg_type == SCM_TIMESTAMPING) {
+            return (const struct scm_timestamping *)CMSG_DATA(cm);
+        }
+    }
+    return NULL;
+}
+
+#endif /* SOMEIP_UDP_H */
@@ -19,36 +19,48 @@ echo "Log file: $logfile"
 echo ""
 
 # 1. RT Determinism
-echo "[1/5] Running RT Determinism Tests..."
+echo "[1/7] Running RT Determinism Tests..."
 cd benchmarks/01-rt-determinism
 ./run_all.sh | tee -a ../../$logfile
 cd ../..
 
 # 2. Communication Latency
-echo "[2/5] Running Communication Latency Tests..."
+echo "[2/7] Running Communication Latency Tests..."
 cd benchmarks/02-comms-latency
 python3 measure_e2e.py | tee -a ../../$logfile
 cd ../..
 
 # 3. Memory Footprint
-echo "[3/5] Running Memory Footprint Analysis..."
+echo "[3/7] Running Memory Footprint Analysis..."
 cd benchmarks/03-memory-footprint
 ./build_all.sh | tee -a ../../$logfile
 python3 compare_sizes.py | tee -a ../../$logfile
 cd ../..
 
 # 4. Virtualization Overhead
-echo "[4/5] Running Virtualization Tests..."
+echo "[4/7] Running Virtualization Tests..."
 cd benchmarks/04-virtualization-overhead
 ./run_vm_bench.sh | tee -a ../../$logfile
 cd ../..
 
 # 5. Crypto Performance
-echo "[5/5] Running Crypto Performance Tests..."
+echo "[5/7] Running Crypto Performance Tests..."
 cd benchmarks/05-crypto-performance
 python3 plot_crypto.py | tee -a ../../$logfile
 cd ../..
 
+# 6. Scheduler Latency
+echo "[6/7] Running Scheduler Latency Tests..."
+cd benchmarks/06-scheduler-latency
+./run_all.sh | tee -a ../../$logfile
+cd ../..
+
+# 7. Cause-Effect Chains
+echo "[7/7] Running Cause-Effect Chain Tests..."
+cd benchmarks/07-cause-effect-chain
+./run_all.sh | tee -a ../../$logfile
+cd ../..
+
 echo ""
 echo "========================================="
 echo "✓ All benchmarks complete!"